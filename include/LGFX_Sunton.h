@@ -0,0 +1,123 @@
+#pragma once
+
+#include <Arduino.h>
+#include <driver/i2c.h>   // برای I2C_NUM_0
+#include <LovyanGFX.hpp>
+
+#include "Sunton_Boards.h"
+
+#include <lgfx/v1/platforms/esp32s3/Panel_RGB.hpp>
+#include <lgfx/v1/platforms/esp32s3/Bus_RGB.hpp>
+
+// تنظیمات برای بردهای RGB سری Sunton (ESP32-8048S070C / 8048S050C / 4827S043C)
+// LCD: RGB565 ، تاچ: GT911 — مشخصات هر برد در Sunton_Boards.h
+template <class B>
+class LGFX_Sunton : public lgfx::LGFX_Device
+{
+public:
+  lgfx::Bus_RGB     _bus_instance;
+  lgfx::Panel_RGB   _panel_instance;
+  lgfx::Light_PWM   _light_instance;
+  lgfx::Touch_GT911 _touch_instance;
+
+  LGFX_Sunton(void)
+  {
+    { // Panel basic
+      auto cfg = _panel_instance.config();
+      cfg.memory_width  = B::W;
+      cfg.memory_height = B::H;
+      cfg.panel_width   = B::W;
+      cfg.panel_height  = B::H;
+      cfg.offset_x = 0;
+      cfg.offset_y = 0;
+      _panel_instance.config(cfg);
+    }
+
+    { // Panel detail (PSRAM)
+      auto cfg = _panel_instance.config_detail();
+      cfg.use_psram = 1;
+      _panel_instance.config_detail(cfg);
+    }
+
+    { // RGB Bus + timing
+      auto cfg = _bus_instance.config();
+      cfg.panel = &_panel_instance;
+
+      // Data pins (RGB565)
+      cfg.pin_d0  = B::RGB.d[0];  // B0
+      cfg.pin_d1  = B::RGB.d[1];
+      cfg.pin_d2  = B::RGB.d[2];
+      cfg.pin_d3  = B::RGB.d[3];
+      cfg.pin_d4  = B::RGB.d[4];
+      cfg.pin_d5  = B::RGB.d[5];  // G0
+      cfg.pin_d6  = B::RGB.d[6];
+      cfg.pin_d7  = B::RGB.d[7];
+      cfg.pin_d8  = B::RGB.d[8];
+      cfg.pin_d9  = B::RGB.d[9];
+      cfg.pin_d10 = B::RGB.d[10];
+      cfg.pin_d11 = B::RGB.d[11]; // R0
+      cfg.pin_d12 = B::RGB.d[12];
+      cfg.pin_d13 = B::RGB.d[13];
+      cfg.pin_d14 = B::RGB.d[14];
+      cfg.pin_d15 = B::RGB.d[15];
+
+      // Control pins
+      cfg.pin_henable = B::RGB.henable;
+      cfg.pin_vsync   = B::RGB.vsync;
+      cfg.pin_hsync   = B::RGB.hsync;
+      cfg.pin_pclk    = B::RGB.pclk;
+
+      // Pixel clock
+      cfg.freq_write  = PANEL_TIMING.pclk_hz;
+
+      // Timing
+      cfg.hsync_polarity    = 0;
+      cfg.hsync_front_porch = PANEL_TIMING.h_front;
+      cfg.hsync_pulse_width = PANEL_TIMING.h_pulse;
+      cfg.hsync_back_porch  = PANEL_TIMING.h_back;
+
+      cfg.vsync_polarity    = 0;
+      cfg.vsync_front_porch = PANEL_TIMING.v_front;
+      cfg.vsync_pulse_width = PANEL_TIMING.v_pulse;
+      cfg.vsync_back_porch  = PANEL_TIMING.v_back;
+
+      cfg.pclk_idle_high    = B::PCLK_IDLE_HIGH;
+
+      _bus_instance.config(cfg);
+    }
+
+    _panel_instance.setBus(&_bus_instance);
+
+    { // Backlight PWM
+      auto cfg = _light_instance.config();
+      cfg.pin_bl = B::PIN_BL;
+      _light_instance.config(cfg);
+    }
+    _panel_instance.light(&_light_instance);
+
+    { // Touch GT911 (I2C0)
+      auto cfg = _touch_instance.config();
+      cfg.x_min = 0;
+      cfg.y_min = 0;
+      cfg.x_max = B::W;
+      cfg.y_max = B::H;
+
+      cfg.bus_shared = false;
+      cfg.offset_rotation = 0;
+
+      cfg.i2c_port = I2C_NUM_0;   // حالا شناخته می‌شود
+      cfg.pin_sda  = B::TOUCH.sda;
+      cfg.pin_scl  = B::TOUCH.scl;
+      cfg.pin_int  = B::TOUCH.intr;
+      cfg.pin_rst  = B::TOUCH.rst;
+      cfg.freq     = 100000;
+
+      _touch_instance.config(cfg);
+      _panel_instance.setTouch(&_touch_instance);
+    }
+
+    setPanel(&_panel_instance);
+  }
+};
+
+using LGFX = LGFX_Sunton<Board>;
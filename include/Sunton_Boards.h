@@ -0,0 +1,139 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Compile-time description of the supported Sunton ESP32-S3 RGB boards.
+// Select one with a build flag (see platformio.ini); the 7" board is the
+// default. Everything that differs between the boards lives here: panel
+// geometry, RGB/touch/backlight pins, timing profiles, LVGL buffer size.
+// The UI layout in main.cpp is derived from W/H at compile time.
+
+// Scan-out timing. The panel reads straight from the PSRAM framebuffer,
+// so a faster pixel clock competes with LVGL for PSRAM bandwidth; pick
+// the fastest profile that panel_test reports without underruns
+// (-DLGFX_PANEL_PROFILE=n).
+struct PanelTiming {
+  const char* name;
+  uint32_t pclk_hz;
+  uint16_t h_front, h_pulse, h_back;
+  uint16_t v_front, v_pulse, v_back;
+
+  constexpr uint32_t frame_clocks(uint32_t w, uint32_t h) const
+  {
+    return (w + h_front + h_pulse + h_back) * (h + v_front + v_pulse + v_back);
+  }
+  constexpr float refresh_hz(uint32_t w, uint32_t h) const
+  {
+    return (float)pclk_hz / (float)frame_clocks(w, h);
+  }
+};
+
+// RGB565 data lines d0..d15 = B0..B4, G0..G5, R0..R4
+struct RgbPins {
+  gpio_num_t d[16];
+  gpio_num_t henable, vsync, hsync, pclk;
+};
+
+struct TouchGT911Pins {
+  gpio_num_t sda, scl, intr, rst;
+};
+
+/* ===================== ESP32-8048S070C (7", 800x480) ===================== */
+struct Sunton_8048S070C {
+  static constexpr const char* NAME = "8048S070C";
+  static constexpr uint16_t W = 800;
+  static constexpr uint16_t H = 480;
+
+  static constexpr RgbPins RGB = {
+    { GPIO_NUM_15, GPIO_NUM_7,  GPIO_NUM_6,  GPIO_NUM_5,  GPIO_NUM_4,
+      GPIO_NUM_9,  GPIO_NUM_46, GPIO_NUM_3,  GPIO_NUM_8,  GPIO_NUM_16, GPIO_NUM_1,
+      GPIO_NUM_14, GPIO_NUM_21, GPIO_NUM_47, GPIO_NUM_48, GPIO_NUM_45 },
+    GPIO_NUM_41, GPIO_NUM_40, GPIO_NUM_39, GPIO_NUM_42
+  };
+  static constexpr bool PCLK_IDLE_HIGH = true;
+  static constexpr gpio_num_t PIN_BL = GPIO_NUM_2;
+  static constexpr TouchGT911Pins TOUCH = { GPIO_NUM_19, GPIO_NUM_20, GPIO_NUM_NC, GPIO_NUM_38 };
+
+  static constexpr uint16_t DRAW_LINES = 12;   // per LVGL draw buffer (two of them, internal RAM)
+
+  static constexpr PanelTiming PROFILES[] = {
+    { "12MHz",       12000000, 8, 2, 43, 8, 2, 12 },   // stock, ~28 Hz
+    { "14MHz",       14000000, 8, 2, 43, 8, 2, 12 },   // ~33 Hz
+    { "16MHz",       16000000, 8, 2, 43, 8, 2, 12 },   // ~37 Hz
+    { "16MHz kurz",  16000000, 8, 4,  8, 8, 4,  8 },   // short porches, ~39 Hz
+    { "18MHz kurz",  18000000, 8, 4,  8, 8, 4,  8 },   // ~44 Hz
+  };
+};
+
+/* ===================== ESP32-8048S050C (5", 800x480) ===================== */
+struct Sunton_8048S050C {
+  static constexpr const char* NAME = "8048S050C";
+  static constexpr uint16_t W = 800;
+  static constexpr uint16_t H = 480;
+
+  static constexpr RgbPins RGB = {
+    { GPIO_NUM_8,  GPIO_NUM_3,  GPIO_NUM_46, GPIO_NUM_9,  GPIO_NUM_1,
+      GPIO_NUM_5,  GPIO_NUM_6,  GPIO_NUM_7,  GPIO_NUM_15, GPIO_NUM_16, GPIO_NUM_4,
+      GPIO_NUM_45, GPIO_NUM_48, GPIO_NUM_47, GPIO_NUM_21, GPIO_NUM_14 },
+    GPIO_NUM_40, GPIO_NUM_41, GPIO_NUM_39, GPIO_NUM_42
+  };
+  static constexpr bool PCLK_IDLE_HIGH = true;
+  static constexpr gpio_num_t PIN_BL = GPIO_NUM_2;
+  static constexpr TouchGT911Pins TOUCH = { GPIO_NUM_19, GPIO_NUM_20, GPIO_NUM_NC, GPIO_NUM_38 };
+
+  static constexpr uint16_t DRAW_LINES = 12;
+
+  static constexpr PanelTiming PROFILES[] = {
+    { "12MHz", 12000000, 8, 4, 8, 8, 4, 8 },   // ~29 Hz
+    { "14MHz", 14000000, 8, 4, 8, 8, 4, 8 },   // ~34 Hz
+    { "16MHz", 16000000, 8, 4, 8, 8, 4, 8 },   // ~39 Hz
+  };
+};
+
+/* ===================== ESP32-4827S043C (4.3", 480x272) ===================== */
+struct Sunton_4827S043C {
+  static constexpr const char* NAME = "4827S043C";
+  static constexpr uint16_t W = 480;
+  static constexpr uint16_t H = 272;
+
+  static constexpr RgbPins RGB = {
+    { GPIO_NUM_8,  GPIO_NUM_3,  GPIO_NUM_46, GPIO_NUM_9,  GPIO_NUM_1,
+      GPIO_NUM_5,  GPIO_NUM_6,  GPIO_NUM_7,  GPIO_NUM_15, GPIO_NUM_16, GPIO_NUM_4,
+      GPIO_NUM_45, GPIO_NUM_48, GPIO_NUM_47, GPIO_NUM_21, GPIO_NUM_14 },
+    GPIO_NUM_40, GPIO_NUM_41, GPIO_NUM_39, GPIO_NUM_42
+  };
+  static constexpr bool PCLK_IDLE_HIGH = true;
+  static constexpr gpio_num_t PIN_BL = GPIO_NUM_2;
+  static constexpr TouchGT911Pins TOUCH = { GPIO_NUM_19, GPIO_NUM_20, GPIO_NUM_NC, GPIO_NUM_38 };
+
+  static constexpr uint16_t DRAW_LINES = 20;
+
+  static constexpr PanelTiming PROFILES[] = {
+    { "8MHz", 8000000, 8, 4, 43, 8, 4, 12 },   // ~50 Hz
+    { "9MHz", 9000000, 8, 4, 43, 8, 4, 12 },   // ~57 Hz
+  };
+};
+
+/* ===================== Selection ===================== */
+#if defined(BOARD_SUNTON_8048S050C)
+using Board = Sunton_8048S050C;
+#elif defined(BOARD_SUNTON_4827S043C)
+using Board = Sunton_4827S043C;
+#else
+using Board = Sunton_8048S070C;
+#endif
+
+#ifndef LGFX_PANEL_PROFILE
+#define LGFX_PANEL_PROFILE 0
+#endif
+static_assert(LGFX_PANEL_PROFILE < sizeof(Board::PROFILES) / sizeof(Board::PROFILES[0]), "unknown LGFX_PANEL_PROFILE for this board");
+static constexpr const PanelTiming& PANEL_TIMING = Board::PROFILES[LGFX_PANEL_PROFILE];
+
+// true if the board itself wires pin p (panel, touch, backlight)
+template <class B>
+constexpr bool board_uses_pin(int p)
+{
+  for (gpio_num_t d : B::RGB.d) if (d == p) return true;
+  return p == B::RGB.henable || p == B::RGB.vsync || p == B::RGB.hsync || p == B::RGB.pclk ||
+         p == B::PIN_BL || p == B::TOUCH.sda || p == B::TOUCH.scl || p == B::TOUCH.intr || p == B::TOUCH.rst;
+}
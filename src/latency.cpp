@@ -0,0 +1,48 @@
+#include "latency.h"
+
+static uint8_t bucket(uint32_t us)
+{
+  const uint32_t v = us >> 6;
+  if (v < 16) return (uint8_t)v;
+  const uint32_t e = 31 - __builtin_clz(v);   // >= 4
+  const uint32_t idx = (e - 3) * 16 + ((v >> (e - 4)) & 15);
+  return idx < LatStat::BUCKETS ? (uint8_t)idx : LatStat::BUCKETS - 1;
+}
+
+static uint32_t bucket_top_us(uint8_t idx)
+{
+  if (idx < 16) return (uint32_t)(idx + 1) << 6;
+  const uint32_t e = idx / 16 + 3;
+  const uint32_t m = idx % 16;
+  return ((17 + m) << (e - 4)) << 6;
+}
+
+void LatStat::reset()
+{
+  memset(this, 0, sizeof(*this));
+  min_us = UINT32_MAX;
+}
+
+void LatStat::add(uint32_t us)
+{
+  n++;
+  sum_us += us;
+  if (us < min_us) min_us = us;
+  if (us > max_us) max_us = us;
+  hist[bucket(us)]++;
+}
+
+uint32_t LatStat::percentile_us(uint16_t permille) const
+{
+  if (n == 0) return 0;
+  const uint32_t want = (uint32_t)(((uint64_t)n * permille + 999) / 1000);
+  uint32_t acc = 0;
+  for (uint8_t i = 0; i < BUCKETS; i++) {
+    acc += hist[i];
+    if (acc >= want) {
+      const uint32_t top = bucket_top_us(i);
+      return top < max_us ? top : max_us;
+    }
+  }
+  return max_us;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <Arduino.h>
+
+/* ===================== Latency statistics =====================
+   Min/avg/max plus a fixed log-linear histogram for percentiles: 64 us
+   steps up to 1 ms, then 16 buckets per power of two (about 6 %
+   resolution) up to ~1 s; anything slower lands in the last bucket.
+   No allocation, add() is a handful of instructions. Not thread-safe:
+   feed and read it from the same task (loop()). */
+struct LatStat {
+  static constexpr uint8_t BUCKETS = 176;
+
+  uint32_t n;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint64_t sum_us;
+  uint32_t hist[BUCKETS];
+
+  void reset();
+  void add(uint32_t us);
+  uint32_t avg_us() const { return n ? (uint32_t)(sum_us / n) : 0; }
+  // upper edge of the bucket holding the given fraction, capped at max_us
+  uint32_t percentile_us(uint16_t permille) const;
+};
@@ -1,12 +1,99 @@
 #include <Arduino.h>
 #include <Preferences.h>
 #include <lvgl.h>
-#include "LGFX_Sunton_8048S070C.h"
+#include <driver/pcnt.h>
+#include "LGFX_Sunton.h"
+#include "modbus_rtu.h"
+#include "telemetry.h"
+#include "mirror.h"
+#include "panel_test.h"
+#include "latency.h"
 
 /* ===================== BEST PINS (CONFIRMED FROM YOUR BOARD PHOTO) ===================== */
 /* PC817 OUTPUT -> P5 IO17  |  MOTOR RELAY DRIVER IN -> P2 IO12 */
-static constexpr gpio_num_t PIN_SENSOR_IN = GPIO_NUM_17;   // P5: IO17
-static constexpr gpio_num_t PIN_MOTOR_OUT = GPIO_NUM_12;   // P2: IO12
+/* One entry per lane (Spur). Lane 0 is the original single-lane wiring;
+   drop the second entry for a one-lane station. */
+static constexpr gpio_num_t LANE_PIN_IN[]  = { GPIO_NUM_17, GPIO_NUM_18 };   // P5: IO17, IO18
+static constexpr gpio_num_t LANE_PIN_OUT[] = { GPIO_NUM_12, GPIO_NUM_11 };   // P2: IO12, IO11
+static constexpr uint8_t LANES = sizeof(LANE_PIN_IN) / sizeof(LANE_PIN_IN[0]);
+static_assert(LANES == sizeof(LANE_PIN_OUT) / sizeof(LANE_PIN_OUT[0]), "one motor pin per sensor pin");
+
+/* Length mode: quadrature encoder on lane 0, A = lane 0 sensor pin, B below.
+   Decoded x4 by the PCNT peripheral, so encoder rate never reaches the CPU. */
+static constexpr uint8_t     ENC_LANE    = 0;
+static constexpr gpio_num_t  ENC_PIN_A   = LANE_PIN_IN[ENC_LANE];
+static constexpr gpio_num_t  ENC_PIN_B   = GPIO_NUM_13;
+static constexpr bool        ENC_REVERSE = false;              // swap if the belt counts backwards
+static constexpr pcnt_unit_t ENC_UNIT    = PCNT_UNIT_0;
+static constexpr int16_t     ENC_LIM     = 30000;              // PCNT is 16 bit; wraps are accumulated
+static constexpr uint16_t    ENC_FILTER  = 100;                // glitch filter, APB cycles (80 MHz)
+
+static constexpr bool lane_pins_free()
+{
+  for (uint8_t i = 0; i < LANES; i++) {
+    if (board_uses_pin<Board>(LANE_PIN_IN[i]) || board_uses_pin<Board>(LANE_PIN_OUT[i])) return false;
+  }
+  return !board_uses_pin<Board>(ENC_PIN_B);
+}
+static_assert(lane_pins_free(), "a lane/encoder pin is already used by the display board");
+
+/* Modbus RTU slave (RS485 module on a spare UART). IO13 is also encoder B,
+   a station uses one or the other. */
+static constexpr bool        MB_ENABLE   = false;
+static constexpr uart_port_t MB_UART     = UART_NUM_2;
+static constexpr gpio_num_t  MB_PIN_TX   = GPIO_NUM_10;
+static constexpr gpio_num_t  MB_PIN_RX   = GPIO_NUM_13;
+static constexpr gpio_num_t  MB_PIN_DE   = GPIO_NUM_NC;   // auto-direction module
+static constexpr uint32_t    MB_BAUD     = 19200;
+static constexpr uint8_t     MB_SLAVE_ID = 1;
+
+static constexpr bool mb_pin_free(gpio_num_t p)
+{
+  if (p == GPIO_NUM_NC) return true;
+  for (uint8_t i = 0; i < LANES; i++) {
+    if (p == LANE_PIN_IN[i] || p == LANE_PIN_OUT[i]) return false;
+  }
+  return !board_uses_pin<Board>(p);
+}
+static_assert(!MB_ENABLE || (mb_pin_free(MB_PIN_TX) && mb_pin_free(MB_PIN_RX) && mb_pin_free(MB_PIN_DE)),
+              "a Modbus pin is already used by the display board or a lane");
+
+/* Length mode needs encoder B to itself; with Modbus on that pin the METER
+   switch is hidden and a stored length mode is ignored. */
+static constexpr bool ENC_USABLE =
+    !(MB_ENABLE && (MB_PIN_TX == ENC_PIN_B || MB_PIN_RX == ENC_PIN_B || MB_PIN_DE == ENC_PIN_B));
+
+/* Binary telemetry on Serial instead of text logging (decode with
+   tools/telemetry_view.py). One record per lane every TEL_PERIOD_MS. */
+static constexpr bool     TEL_ENABLE    = false;
+static constexpr uint32_t TEL_PERIOD_MS = 100;
+
+/* Remote screen mirror over Serial (tools/mirror_view.py). Needs the faster
+   link; the budget caps the readback/encode time taken per loop(). */
+static constexpr bool     MIRROR_ENABLE    = false;
+static constexpr uint32_t MIRROR_BUDGET_US = 1500;
+
+static constexpr uint32_t SERIAL_BAUD = MIRROR_ENABLE ? 921600 : 115200;
+static constexpr bool     TEXT_LOG    = !TEL_ENABLE && !MIRROR_ENABLE;   // Serial free for text
+static_assert(!(TEL_ENABLE && MIRROR_ENABLE), "telemetry and mirror share Serial");
+
+/* RGB scan-out (pixel clock/porches: LGFX_PANEL_PROFILE in the LGFX header).
+   PANEL_RESYNC restarts the panel DMA every frame so a PSRAM underrun
+   cannot leave the picture shifted; PANEL_TEST runs the display stress
+   test once at boot and logs the results before the UI starts. */
+static constexpr bool     PANEL_RESYNC        = false;
+static constexpr bool     PANEL_TEST          = false;
+static constexpr uint32_t PANEL_TEST_PHASE_MS = 5000;
+
+/* Pulse-to-pixel latency: sensor ISR -> sync_count -> update_main_ui ->
+   flush of the area holding lbl_ist_big, plus target pulse -> motor off.
+   Long-press the main header for the diagnostics screen; a summary goes to
+   Serial every LAT_REPORT_MS unless Serial carries binary frames. */
+static constexpr bool     LAT_ENABLE    = false;
+static constexpr uint32_t LAT_REPORT_MS = 10000;
+
+/* Diagnostics screen: latency figures and/or Modbus frame counters */
+static constexpr bool DIAG_ENABLE = LAT_ENABLE || MB_ENABLE;
 
 static constexpr bool SENSOR_ACTIVE_LOW = false;            // PC817 open-collector + pullup => active LOW
 static constexpr bool MOTOR_ACTIVE_HIGH = true;            // typical relay/MOSFET module IN active HIGH
@@ -16,13 +103,51 @@ static constexpr uint32_t NO_PULSE_TIMEOUT_MS = 5000;      // running but no pul
 static constexpr uint32_t MIN_PULSE_GAP_US_HARD = 500;     // reject very fast noise
 
 /* ===================== DISPLAY/LVGL ===================== */
-static const uint16_t SCREEN_W = 800;
-static const uint16_t SCREEN_H = 480;
+/* Board: -DBOARD_SUNTON_... in platformio.ini, see Sunton_Boards.h */
+static constexpr uint16_t SCREEN_W = Board::W;
+static constexpr uint16_t SCREEN_H = Board::H;
+static constexpr uint32_t DRAW_BUF_PX = (uint32_t)SCREEN_W * Board::DRAW_LINES;
 
 static LGFX gfx;
 static lv_disp_draw_buf_t draw_buf;
-static lv_color_t buf1[SCREEN_W * 12];
-static lv_color_t buf2[SCREEN_W * 12];
+static lv_color_t buf1[DRAW_BUF_PX];
+static lv_color_t buf2[DRAW_BUF_PX];
+
+/* Screen geometry. The 800x480 reference layout scaled to the board's panel
+   at compile time, so smaller boards get the same screens at no runtime
+   cost. sx()/sy() take reference pixels. */
+template <class B>
+struct LayoutFor {
+  static constexpr lv_coord_t sx(int v) { return (lv_coord_t)(v * (int)B::W / 800); }
+  static constexpr lv_coord_t sy(int v) { return (lv_coord_t)(v * (int)B::H / 480); }
+
+  static constexpr lv_coord_t MARGIN    = sx(10);
+  static constexpr lv_coord_t GAP       = sx(10);
+  static constexpr lv_coord_t CONTENT_W = B::W - 2 * MARGIN;
+  static constexpr lv_coord_t HEADER_H  = sy(70);
+  static constexpr lv_coord_t CARD_Y    = HEADER_H + sy(6);
+  static constexpr lv_coord_t FIELD_H   = sy(60);
+
+  // main screen: header | lane tiles | count frame | button row
+  static constexpr lv_coord_t TILE_Y     = CARD_Y;
+  static constexpr lv_coord_t TILE_H     = sy(52);
+  static constexpr lv_coord_t TILE_GAP   = sx(8);
+  static constexpr lv_coord_t FRAME_Y    = TILE_Y + TILE_H + sy(8);
+  static constexpr lv_coord_t FRAME_H    = sy(244);
+  static constexpr lv_coord_t FRAME_PAD  = sx(16);
+  static constexpr lv_coord_t FRAME_IN_W = CONTENT_W - 2 * FRAME_PAD;
+  static constexpr lv_coord_t COL_H      = sy(120);
+  static constexpr lv_coord_t BIG_Y      = sy(40);
+  static constexpr lv_coord_t ROW_H      = B::H - FRAME_Y - FRAME_H - sy(8);
+  static constexpr uint8_t    BTN_N      = 5;
+  static constexpr lv_coord_t BTN_H      = ROW_H - 2 * MARGIN;
+  static constexpr lv_coord_t BTN_W      = (B::W - 2 * MARGIN - (BTN_N - 1) * GAP) / BTN_N;
+
+  // 4.3" and smaller: status line and lane tiles use the short texts
+  static constexpr bool       COMPACT    = B::W < 640;
+};
+using UI = LayoutFor<Board>;
+static_assert(UI::BTN_W >= 80 && UI::BTN_H >= 40, "main buttons too small to hit on this panel");
 
 /* Fonts (ASCII only -> default font OK) */
 static const lv_font_t* F16 = LV_FONT_DEFAULT;
@@ -39,69 +164,314 @@ static lv_color_t C_RED;
 /* Persistence */
 static Preferences prefs;
 static const char* NVS_NS    = "bandware";
-static const char* KEY_ZIEL  = "ziel";
+static const char* KEY_ZIEL  = "ziel";    // lane 0; other lanes append the lane number
 static const char* KEY_DEBMS = "debms";
+static const char* KEY_JOBS  = "jobs";
+static const char* KEY_JOBN  = "jobn";
+static const char* KEY_JOBAU = "jobauto";
+static const char* KEY_LEN   = "lenmode";
+static const char* KEY_PPM   = "ppm";
 
 /* State */
-enum class State : uint8_t { IDLE, RUNNING, DONE, STOPPED, ERROR };
-
-static volatile uint32_t isr_count = 0;
-static volatile uint32_t isr_last_us = 0;
-
-static uint32_t ist = 0;
-static uint32_t ziel = 120;
-static uint16_t deb_ms = 5;
-
-static State st = State::IDLE;
-static bool motor_on = false;
-static uint32_t last_pulse_seen_ms = 0;
+enum class State : uint8_t { IDLE, RUNNING, DONE, STOPPED, ERROR, CHANGEOVER };
+
+/* Job queue (pending batches, persisted in NVS) */
+static constexpr uint8_t  MAX_JOBS = 8;
+static constexpr uint16_t MAX_JOB_DELAY_S = 600;
+
+struct Job {
+  uint32_t ziel;          // target pieces
+  uint16_t delay_s;       // pause before auto-restart (0 = motor keeps running)
+  char     label[14];     // optional, shown on main screen
+};
+static_assert(sizeof(Job) == 20, "Job layout is stored as NVS blob");
+
+/* ISR side, one slot per lane. isr_gap_us is deb_ms pre-scaled so the ISR
+   does a single compare. */
+static volatile uint32_t isr_count[LANES]   = {0};
+static volatile uint32_t isr_last_us[LANES] = {0};
+static volatile uint32_t isr_gap_us[LANES]  = {0};
+
+/* Stamps of the last LAT_RING pulses, indexed by the count each produced,
+   so the pulse that reached the target can still be found afterwards. */
+static constexpr uint8_t LAT_RING = 8;   // power of two
+static volatile uint32_t isr_ts[LANES][LAT_RING] = {};
+
+/* Lane table (struct of arrays): the control loop walks one field for all
+   lanes at a time, so each pass touches a single contiguous array. */
+struct LaneTable {
+  uint32_t ist[LANES];
+  uint32_t ziel[LANES];
+  uint16_t deb_ms[LANES];
+  State    st[LANES];
+  bool     motor_on[LANES];
+  uint32_t last_pulse_ms[LANES];
+};
+static LaneTable lane = {};
+
+/* Length mode (ENC_LANE only): ist/ziel are centimetres */
+static bool len_mode = false;
+static uint32_t enc_ppm = 1000;            // encoder edges (x4) per metre
+static int64_t enc_base = 0;               // encoder position of ist = 0
+static volatile int32_t enc_wraps = 0;     // +-ENC_LIM per PCNT limit event
+static bool enc_ready = false;
+static bool set_len_mode = false;          // pending value while the settings screen is open
+
+static constexpr uint8_t JOB_LANE = 0;     // the job queue feeds this lane
+static uint8_t sel = 0;                    // lane shown big + targeted by the buttons
+static uint8_t done_lane = 0;
+static uint8_t err_lane = 0;
 static char err_msg[128] = {0};
 
+static Job jobs[MAX_JOBS];
+static uint8_t job_n = 0;
+static bool job_auto = false;
+static char job_label[sizeof(Job::label)] = {0};   // label of the active batch
+static bool jobs_dirty = false;      // queue changed; NVS write waits until no lane runs
+static bool ziel_from_job = false;   // JOB_LANE target came from the queue: RAM only
+static uint32_t changeover_until_ms = 0;
+
 /* Screens */
 static lv_obj_t* scr_main = nullptr;
 static lv_obj_t* scr_set  = nullptr;
 static lv_obj_t* scr_done = nullptr;
 static lv_obj_t* scr_err  = nullptr;
+static lv_obj_t* scr_jobs = nullptr;
+static lv_obj_t* scr_diag = nullptr;
 
 /* Main widgets */
+static lv_obj_t* btn_lane[LANES] = {nullptr};
+static lv_obj_t* lbl_lane[LANES] = {nullptr};
 static lv_obj_t* lbl_ist_big  = nullptr;
 static lv_obj_t* lbl_ziel_big = nullptr;
 static lv_obj_t* lbl_status   = nullptr;
 static lv_obj_t* bar          = nullptr;
 
+/* Last values drawn per lane tile; a tile is only touched when these change */
+static uint32_t ui_ist[LANES];
+static uint32_t ui_ziel[LANES];
+static State    ui_st[LANES];
+static bool     ui_valid = false;
+
 /* Settings widgets */
+static lv_obj_t* lbl_set_title = nullptr;
 static lv_obj_t* ta_ziel   = nullptr;
 static lv_obj_t* ta_deb    = nullptr;
+static lv_obj_t* ta_ppm    = nullptr;
+static lv_obj_t* btn_mode  = nullptr;
+static lv_obj_t* lbl_ppm   = nullptr;
 static lv_obj_t* kb        = nullptr;
 static lv_obj_t* btn_clear = nullptr;
 
+/* Job queue widgets */
+static lv_obj_t* ta_job_ziel  = nullptr;
+static lv_obj_t* ta_job_delay = nullptr;
+static lv_obj_t* ta_job_label = nullptr;
+static lv_obj_t* kb_job       = nullptr;
+static lv_obj_t* lbl_jobs     = nullptr;
+static lv_obj_t* lbl_job_auto = nullptr;
+
 /* Done/Error widgets */
 static lv_obj_t* lbl_done = nullptr;
 static lv_obj_t* lbl_err  = nullptr;
+static lv_obj_t* lbl_diag = nullptr;
 
 /* ===================== HW helpers ===================== */
-static inline void motorWrite(bool on)
+static inline void motorWrite(uint8_t i, bool on)
+{
+  lane.motor_on[i] = on;
+  if (MOTOR_ACTIVE_HIGH) digitalWrite((int)LANE_PIN_OUT[i], on ? HIGH : LOW);
+  else                   digitalWrite((int)LANE_PIN_OUT[i], on ? LOW : HIGH);
+}
+
+static void setDebounce(uint8_t i, uint16_t ms)
+{
+  lane.deb_ms[i] = ms;
+  uint32_t gap = (uint32_t)ms * 1000UL;
+  if (gap < MIN_PULSE_GAP_US_HARD) gap = MIN_PULSE_GAP_US_HARD;
+  isr_gap_us[i] = gap;
+}
+
+/* ===================== Encoder (PCNT) ===================== */
+static void IRAM_ATTR enc_limit_isr(void*)
+{
+  uint32_t status = 0;
+  pcnt_get_event_status(ENC_UNIT, &status);
+  if (status & PCNT_EVT_H_LIM) enc_wraps += ENC_LIM;
+  if (status & PCNT_EVT_L_LIM) enc_wraps -= ENC_LIM;
+}
+
+static void enc_begin()
+{
+  if (enc_ready) {
+    pcnt_counter_resume(ENC_UNIT);
+    return;
+  }
+
+  // x4 quadrature: each channel counts edges of one input, direction from the other
+  pcnt_config_t c = {};
+  c.unit           = ENC_UNIT;
+  c.channel        = PCNT_CHANNEL_0;
+  c.pulse_gpio_num = ENC_PIN_A;
+  c.ctrl_gpio_num  = ENC_PIN_B;
+  c.pos_mode       = PCNT_COUNT_DEC;
+  c.neg_mode       = PCNT_COUNT_INC;
+  c.lctrl_mode     = PCNT_MODE_REVERSE;
+  c.hctrl_mode     = PCNT_MODE_KEEP;
+  c.counter_h_lim  = ENC_LIM;
+  c.counter_l_lim  = -ENC_LIM;
+  pcnt_unit_config(&c);
+
+  c.channel        = PCNT_CHANNEL_1;
+  c.pulse_gpio_num = ENC_PIN_B;
+  c.ctrl_gpio_num  = ENC_PIN_A;
+  c.pos_mode       = PCNT_COUNT_INC;
+  c.neg_mode       = PCNT_COUNT_DEC;
+  pcnt_unit_config(&c);
+
+  pcnt_set_filter_value(ENC_UNIT, ENC_FILTER);
+  pcnt_filter_enable(ENC_UNIT);
+
+  pcnt_event_enable(ENC_UNIT, PCNT_EVT_H_LIM);
+  pcnt_event_enable(ENC_UNIT, PCNT_EVT_L_LIM);
+  pcnt_counter_pause(ENC_UNIT);
+  pcnt_counter_clear(ENC_UNIT);
+  pcnt_isr_service_install(0);
+  pcnt_isr_handler_add(ENC_UNIT, enc_limit_isr, nullptr);
+  pcnt_intr_enable(ENC_UNIT);
+  pcnt_counter_resume(ENC_UNIT);
+  enc_ready = true;
+}
+
+/* Absolute encoder position; re-read if a limit event landed in between */
+static int64_t enc_total()
+{
+  int32_t w;
+  int16_t c = 0;
+  do {
+    w = enc_wraps;
+    pcnt_get_counter_value(ENC_UNIT, &c);
+  } while (w != enc_wraps);
+
+  const int64_t t = (int64_t)w + c;
+  return ENC_REVERSE ? -t : t;
+}
+
+static uint32_t enc_ist_cm()
+{
+  const int64_t net = enc_total() - enc_base;
+  if (net <= 0) return 0;   // belt moved back past the start
+  return (uint32_t)(net * 100 / enc_ppm);
+}
+
+/* Subtracts carry_from from lane i's count (clamped at 0). Pulse lanes do it
+   with the ISR masked, so pulses arriving meanwhile are kept. */
+static void rebaseCount(uint8_t i, uint32_t carry_from)
+{
+  if (i == ENC_LANE && len_mode) {
+    const int64_t total = enc_total();
+    const int64_t carry = (int64_t)carry_from * enc_ppm / 100;
+    enc_base = (total - enc_base > carry) ? enc_base + carry : total;
+    lane.ist[i] = enc_ist_cm();
+    return;
+  }
+
+  noInterrupts();
+  isr_count[i] = (isr_count[i] > carry_from) ? isr_count[i] - carry_from : 0;
+  lane.ist[i] = isr_count[i];
+  interrupts();
+}
+
+static void resetCount(uint8_t i)
 {
-  motor_on = on;
-  if (MOTOR_ACTIVE_HIGH) digitalWrite((int)PIN_MOTOR_OUT, on ? HIGH : LOW);
-  else                   digitalWrite((int)PIN_MOTOR_OUT, on ? LOW : HIGH);
+  rebaseCount(i, UINT32_MAX);
 }
 
-static void saveSettings()
+/* Formats a count, or metres with two decimals for the encoder lane */
+static void fmtQty(char* buf, size_t n, uint8_t i, uint32_t v, bool unit)
 {
-  prefs.putUInt(KEY_ZIEL, ziel);
-  prefs.putUShort(KEY_DEBMS, deb_ms);
+  if (i == ENC_LANE && len_mode) {
+    snprintf(buf, n, unit ? "%lu.%02lu m" : "%lu.%02lu", (unsigned long)(v / 100), (unsigned long)(v % 100));
+  } else {
+    snprintf(buf, n, "%lu", (unsigned long)v);
+  }
+}
+
+static uint32_t parseZiel(uint8_t i, const char* txt)
+{
+  uint32_t z;
+  if (i == ENC_LANE && len_mode) {
+    const float m = strtof(txt, nullptr);
+    z = (m > 0.0f) ? (uint32_t)(m * 100.0f + 0.5f) : 0;
+  } else {
+    z = (uint32_t)strtoul(txt, nullptr, 10);
+  }
+  if (z < 1) z = 1;
+  if (z > 999999) z = 999999;
+  return z;
+}
+
+static const char* laneKey(char* buf, size_t n, const char* base, uint8_t i)
+{
+  if (i == 0) return base;   // keeps settings stored by single-lane firmware
+  snprintf(buf, n, "%s%u", base, (unsigned)i);
+  return buf;
+}
+
+static void saveSettings(uint8_t i)
+{
+  char k[16];
+  // a job's target is not the operator's setting; NVS keeps the latter
+  if (!(i == JOB_LANE && ziel_from_job)) prefs.putUInt(laneKey(k, sizeof(k), KEY_ZIEL, i), lane.ziel[i]);
+  prefs.putUShort(laneKey(k, sizeof(k), KEY_DEBMS, i), lane.deb_ms[i]);
 }
 
 static void loadSettings()
 {
-  ziel   = prefs.getUInt(KEY_ZIEL, 120);
-  deb_ms = prefs.getUShort(KEY_DEBMS, 5);
+  char k[16];
+  for (uint8_t i = 0; i < LANES; i++) {
+    uint32_t z = prefs.getUInt(laneKey(k, sizeof(k), KEY_ZIEL, i), 120);
+    uint16_t d = prefs.getUShort(laneKey(k, sizeof(k), KEY_DEBMS, i), 5);
+
+    if (z < 1) z = 1;
+    if (z > 999999) z = 999999;
+    if (d < 1) d = 1;
+    if (d > 100) d = 100;
+
+    lane.ziel[i] = z;
+    setDebounce(i, d);
+  }
+
+  len_mode = ENC_USABLE && prefs.getBool(KEY_LEN, false);
+  enc_ppm  = prefs.getUInt(KEY_PPM, 1000);
+  if (enc_ppm < 1) enc_ppm = 1;
+  if (enc_ppm > 1000000) enc_ppm = 1000000;
+}
+
+static void saveJobs()
+{
+  prefs.putBytes(KEY_JOBS, jobs, sizeof(Job) * job_n);
+  prefs.putUChar(KEY_JOBN, job_n);
+  prefs.putBool(KEY_JOBAU, job_auto);
+  jobs_dirty = false;
+}
+
+static void loadJobs()
+{
+  job_auto = prefs.getBool(KEY_JOBAU, false);
+  job_n    = prefs.getUChar(KEY_JOBN, 0);
+  if (job_n > MAX_JOBS || prefs.getBytesLength(KEY_JOBS) != sizeof(Job) * job_n) {
+    job_n = 0;   // missing or stale blob => start with an empty queue
+    return;
+  }
+  prefs.getBytes(KEY_JOBS, jobs, sizeof(Job) * job_n);
 
-  if (ziel < 1) ziel = 1;
-  if (ziel > 999999) ziel = 999999;
-  if (deb_ms < 1) deb_ms = 1;
-  if (deb_ms > 100) deb_ms = 100;
+  for (uint8_t i = 0; i < job_n; i++) {
+    if (jobs[i].ziel < 1) jobs[i].ziel = 1;
+    if (jobs[i].ziel > 999999) jobs[i].ziel = 999999;
+    if (jobs[i].delay_s > MAX_JOB_DELAY_S) jobs[i].delay_s = MAX_JOB_DELAY_S;
+    jobs[i].label[sizeof(jobs[i].label) - 1] = 0;
+  }
 }
 
 static const char* stateText(State s)
@@ -112,22 +482,80 @@ static const char* stateText(State s)
     case State::DONE:    return "Fertig";
     case State::STOPPED: return "Stopp";
     case State::ERROR:   return "Fehler";
+    case State::CHANGEOVER: return "Wechsel...";
   }
   return "";
 }
 
 /* ===================== ISR ===================== */
-static void IRAM_ATTR sensor_isr()
+/* Shared by all lanes; the lane index is the attachInterruptArg() argument. */
+static void IRAM_ATTR sensor_isr(void* arg)
 {
   const uint32_t now = (uint32_t)esp_timer_get_time(); // us
+  const uint8_t i = (uint8_t)(uintptr_t)arg;
+
+  if ((uint32_t)(now - isr_last_us[i]) < isr_gap_us[i]) return;
+
+  isr_last_us[i] = now;
+  const uint32_t c = isr_count[i] + 1;
+  isr_count[i] = c;
+  if (LAT_ENABLE) isr_ts[i][c & (LAT_RING - 1)] = now;
+}
 
-  if ((uint32_t)(now - isr_last_us) < MIN_PULSE_GAP_US_HARD) return;
+/* ===================== Latency ===================== */
+/* loop() context only. Times are esp_timer microseconds truncated to 32 bit
+   like the ISR stamps; differences stay valid for ~71 minutes. */
+static constexpr uint32_t LAT_STALE_US = 1000000;   // older: label was not on screen, drop
 
-  const uint32_t min_delta = (uint32_t)deb_ms * 1000UL;
-  if ((uint32_t)(now - isr_last_us) < min_delta) return;
+static LatStat lat_sync;    // pulse -> seen by sync_count()
+static LatStat lat_ui;      // pulse -> new text in lbl_ist_big
+static LatStat lat_disp;    // pulse -> flush covering lbl_ist_big written
+static LatStat lat_motor;   // target pulse -> motor output off
 
-  isr_last_us = now;
-  isr_count++;
+static uint32_t lat_ts = 0;           // pulse behind the newest count of lane sel
+static bool     lat_have = false;     // lat_ts not yet on the label
+static bool     lat_pending = false;  // label changed, waiting for its flush
+
+static inline uint32_t lat_now() { return (uint32_t)esp_timer_get_time(); }
+
+static void lat_reset()
+{
+  lat_sync.reset();
+  lat_ui.reset();
+  lat_disp.reset();
+  lat_motor.reset();
+  lat_have = lat_pending = false;
+}
+
+/* The label counts as shown once the flush covering its bottom edge is in
+   the framebuffer; the panel scans it out within one refresh after that. */
+static void lat_on_flush(const lv_area_t* a)
+{
+  lv_area_t c;
+  lv_obj_get_coords(lbl_ist_big, &c);
+  if (a->y1 > c.y2 || a->y2 < c.y2 || a->x1 > c.x2 || a->x2 < c.x1) return;
+
+  gfx.waitDMA();
+  const uint32_t d = lat_now() - lat_ts;
+  if (d < LAT_STALE_US) lat_disp.add(d);
+  lat_pending = false;
+}
+
+/* Stamp of the pulse that made lane i's count equal its target, 0 if it has
+   already left the ring (or the lane counts encoder edges). */
+static uint32_t lat_target_ts(uint8_t i)
+{
+  if (i == ENC_LANE && len_mode) return 0;
+  const uint32_t ziel = lane.ziel[i];
+  if (ziel == 0 || isr_count[i] - ziel >= LAT_RING) return 0;
+  return isr_ts[i][ziel & (LAT_RING - 1)];
+}
+
+static void lat_motor_off(uint32_t ts)
+{
+  if (ts == 0) return;
+  const uint32_t d = lat_now() - ts;
+  if (d < LAT_STALE_US) lat_motor.add(d);
 }
 
 /* ===================== LVGL glue ===================== */
@@ -140,6 +568,11 @@ static void my_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t
                    area->y2 - area->y1 + 1,
                    (lgfx::rgb565_t *)&color_p->full);
 
+  if (LAT_ENABLE && lat_pending) lat_on_flush(area);
+
+  // just remember the area; pixels are read back later within a budget
+  if (MIRROR_ENABLE) mirror_mark(area->x1, area->y1, area->x2, area->y2);
+
   lv_disp_flush_ready(disp);
 }
 
@@ -147,7 +580,7 @@ static void my_touchpad_read(lv_indev_drv_t*, lv_indev_data_t *data)
 {
   uint16_t x, y;
   data->state = LV_INDEV_STATE_REL;
-  if (gfx.getTouch(&x, &y)) {
+  if ((MIRROR_ENABLE && mirror_touch(&x, &y)) || gfx.getTouch(&x, &y)) {
     data->state = LV_INDEV_STATE_PR;
     data->point.x = x;
     data->point.y = y;
@@ -166,25 +599,25 @@ static void style_screen(lv_obj_t* scr)
 static lv_obj_t* make_header(lv_obj_t* scr, const char* title, const char* subtitle)
 {
   lv_obj_t* head = lv_obj_create(scr);
-  lv_obj_set_size(head, 800, 70);
+  lv_obj_set_size(head, SCREEN_W, UI::HEADER_H);
   lv_obj_align(head, LV_ALIGN_TOP_LEFT, 0, 0);
   lv_obj_set_style_bg_color(head, C_ORANGE, 0);
   lv_obj_set_style_bg_opa(head, LV_OPA_COVER, 0);
   lv_obj_set_style_border_width(head, 0, 0);
-  lv_obj_set_style_pad_left(head, 18, 0);
-  lv_obj_set_style_pad_top(head, 10, 0);
+  lv_obj_set_style_pad_left(head, UI::sx(18), 0);
+  lv_obj_set_style_pad_top(head, UI::sy(10), 0);
 
   lv_obj_t* t = lv_label_create(head);
   lv_label_set_text(t, title);
   lv_obj_set_style_text_color(t, C_WHITE, 0);
   lv_obj_set_style_text_font(t, F24, 0);
-  lv_obj_align(t, LV_ALIGN_LEFT_MID, 0, -12);
+  lv_obj_align(t, LV_ALIGN_LEFT_MID, 0, UI::sy(-12));
 
   lv_obj_t* s = lv_label_create(head);
   lv_label_set_text(s, subtitle);
   lv_obj_set_style_text_color(s, C_WHITE, 0);
   lv_obj_set_style_text_font(s, F16, 0);
-  lv_obj_align(s, LV_ALIGN_LEFT_MID, 0, 16);
+  lv_obj_align(s, LV_ALIGN_LEFT_MID, 0, UI::sy(16));
 
   return head;
 }
@@ -230,18 +663,103 @@ static void go(lv_obj_t* scr, lv_scr_load_anim_t anim)
 }
 
 /* ===================== UI updates ===================== */
+/* Snapshots all lane counters in one critical section and stamps the lanes
+   that moved since the last pass. With LAT_ENABLE every pulse of the shown
+   lane that is new to the UI gives one sync sample, and the oldest of them
+   is the one ui/disp are measured from. More than LAT_RING pulses between
+   two passes: the older ones are already overwritten, so the measurement
+   starts at the oldest stamp left. */
 static void sync_count()
 {
-  uint32_t p;
-  noInterrupts(); p = isr_count; interrupts();
-  ist = p;
+  uint32_t p[LANES];
+  uint32_t ts[LAT_RING];
+  noInterrupts();
+  for (uint8_t i = 0; i < LANES; i++) p[i] = isr_count[i];
+  if (LAT_ENABLE) for (uint8_t k = 0; k < LAT_RING; k++) ts[k] = isr_ts[sel][k];
+  interrupts();
+
+  if (len_mode) p[ENC_LANE] = enc_ist_cm();
+
+  const uint32_t now = millis();
+  for (uint8_t i = 0; i < LANES; i++) {
+    if (p[i] != lane.ist[i]) lane.last_pulse_ms[i] = now;
+    if (LAT_ENABLE && i == sel && p[i] > lane.ist[i] && !(i == ENC_LANE && len_mode)) {
+      const uint32_t first = (p[i] - lane.ist[i] > LAT_RING) ? p[i] - LAT_RING + 1 : lane.ist[i] + 1;
+      const uint32_t t_now = lat_now();
+      for (uint32_t c = first; c <= p[i]; c++) {
+        const uint32_t t = ts[c & (LAT_RING - 1)];
+        const uint32_t d = t_now - t;
+        if (d >= LAT_STALE_US) continue;
+        lat_sync.add(d);
+        if (!lat_have) {
+          lat_ts = t;
+          lat_have = true;
+        }
+      }
+    }
+    lane.ist[i] = p[i];
+  }
+}
+
+/* lv_label_set_text() always invalidates, even for identical text */
+static bool set_text_if_changed(lv_obj_t* lbl, const char* txt)
+{
+  if (strcmp(lv_label_get_text(lbl), txt) == 0) return false;
+  lv_label_set_text(lbl, txt);
+  return true;
+}
+
+static void update_lane_tiles()
+{
+  char buf[64], a[20], b[20];
+  for (uint8_t i = 0; i < LANES; i++) {
+    if (ui_valid && ui_ist[i] == lane.ist[i] && ui_ziel[i] == lane.ziel[i] && ui_st[i] == lane.st[i]) continue;
+    ui_ist[i]  = lane.ist[i];
+    ui_ziel[i] = lane.ziel[i];
+    ui_st[i]   = lane.st[i];
+    fmtQty(a, sizeof(a), i, lane.ist[i], false);
+    fmtQty(b, sizeof(b), i, lane.ziel[i], true);
+    snprintf(buf, sizeof(buf), UI::COMPACT ? "%u: %s/%s %s" : "Spur %u:  %s / %s  %s",
+             (unsigned)(i + 1), a, b, stateText(lane.st[i]));
+    lv_label_set_text(lbl_lane[i], buf);
+  }
+  ui_valid = true;
 }
 
 static void update_main_ui()
 {
-  lv_label_set_text_fmt(lbl_ist_big,  "%lu", (unsigned long)ist);
-  lv_label_set_text_fmt(lbl_ziel_big, "%lu", (unsigned long)ziel);
-  lv_label_set_text_fmt(lbl_status,   "Status: %s", stateText(st));
+  const uint8_t i = sel;
+  const uint32_t ist  = lane.ist[i];
+  const uint32_t ziel = lane.ziel[i];
+  const State    st   = lane.st[i];
+  char buf[96];
+
+  update_lane_tiles();
+
+  fmtQty(buf, sizeof(buf), i, ist, true);
+  if (set_text_if_changed(lbl_ist_big, buf) && LAT_ENABLE && lat_have) {
+    lat_ui.add(lat_now() - lat_ts);
+    lat_pending = (lv_scr_act() == scr_main);
+  }
+  lat_have = false;
+  fmtQty(buf, sizeof(buf), i, ziel, true);
+  set_text_if_changed(lbl_ziel_big, buf);
+
+  if (i != JOB_LANE) {
+    snprintf(buf, sizeof(buf), UI::COMPACT ? "Spur %u | %s" : "Spur %u  |  Status: %s",
+             (unsigned)(i + 1), stateText(st));
+  } else if (st == State::CHANGEOVER) {
+    const uint32_t left_ms = changeover_until_ms - millis();
+    snprintf(buf, sizeof(buf), UI::COMPACT ? "Spur %u | %s %lus | %s | WS %u"
+                                           : "Spur %u  |  Status: %s %lus  |  Auftrag: %s  |  Warteschlange: %u",
+             (unsigned)(i + 1), stateText(st), (unsigned long)((left_ms + 999) / 1000),
+             job_label[0] ? job_label : "-", (unsigned)job_n);
+  } else {
+    snprintf(buf, sizeof(buf), UI::COMPACT ? "Spur %u | %s | %s | WS %u"
+                                           : "Spur %u  |  Status: %s  |  Auftrag: %s  |  Warteschlange: %u",
+             (unsigned)(i + 1), stateText(st), job_label[0] ? job_label : "-", (unsigned)job_n);
+  }
+  set_text_if_changed(lbl_status, buf);
 
   int pct = 0;
   if (ziel > 0) {
@@ -251,40 +769,113 @@ static void update_main_ui()
   lv_bar_set_value(bar, pct, LV_ANIM_ON);
 }
 
+static void select_lane(uint8_t i)
+{
+  for (uint8_t k = 0; k < LANES; k++) {
+    lv_obj_set_style_border_width(btn_lane[k], k == i ? 4 : 1, 0);
+  }
+  sel = i;
+  update_main_ui();
+}
+
 /* ===================== Workflow ===================== */
-static void set_error(const char* msg)
+static void set_error(uint8_t i, const char* msg)
 {
-  motorWrite(false);
-  st = State::ERROR;
-  strncpy(err_msg, msg, sizeof(err_msg) - 1);
-  err_msg[sizeof(err_msg) - 1] = 0;
+  motorWrite(i, false);
+  lane.st[i] = State::ERROR;
+  err_lane = i;
+  snprintf(err_msg, sizeof(err_msg), "Spur %u: %s", (unsigned)(i + 1), msg);
   lv_label_set_text(lbl_err, err_msg);
   go(scr_err, LV_SCR_LOAD_ANIM_MOVE_LEFT);
 }
 
-static void process_workflow()
+/* Pops the front job and makes it the active batch. The counter is rebased in
+   the same critical section the ISR is masked by, so no pulse is lost between
+   reading and clearing it; carry_from keeps pulses past the old target.
+   Runs with the motor on, so nothing is written to flash here: the shortened
+   queue is saved by loop() once the lane stops. */
+static void take_next_job(uint32_t carry_from)
 {
-  sync_count();
+  const Job next = jobs[0];
+  memmove(&jobs[0], &jobs[1], sizeof(Job) * (job_n - 1));
+  job_n--;
+  jobs_dirty = true;
 
-  static uint32_t last_ist = 0;
-  uint32_t now = millis();
-  if (ist != last_ist) {
-    last_ist = ist;
-    last_pulse_seen_ms = now;
+  rebaseCount(JOB_LANE, carry_from);
+
+  lane.ziel[JOB_LANE] = next.ziel;
+  ziel_from_job = true;
+  strncpy(job_label, next.label, sizeof(job_label) - 1);
+  job_label[sizeof(job_label) - 1] = 0;
+}
+
+static void advance_job()
+{
+  const uint16_t delay_s = jobs[0].delay_s;
+  take_next_job(lane.ziel[JOB_LANE]);
+
+  if (delay_s == 0) {
+    // zero-downtime changeover: motor stays on
+    lane.st[JOB_LANE] = State::RUNNING;
+    lane.last_pulse_ms[JOB_LANE] = millis();
+  } else {
+    motorWrite(JOB_LANE, false);
+    lane.st[JOB_LANE] = State::CHANGEOVER;
+    changeover_until_ms = millis() + (uint32_t)delay_s * 1000UL;
+  }
+  if (TEXT_LOG) {
+    Serial.printf("JOB NEXT: ziel=%lu label=%s rest=%u\n",
+                  (unsigned long)lane.ziel[JOB_LANE], job_label, (unsigned)job_n);
   }
-  if (last_pulse_seen_ms == 0) last_pulse_seen_ms = now;
+}
 
-  if (st == State::RUNNING && ist >= ziel) {
-    motorWrite(false);
-    st = State::DONE;
-    go(scr_done, LV_SCR_LOAD_ANIM_MOVE_LEFT);
-    return;
+static bool any_lane_running()
+{
+  for (uint8_t i = 0; i < LANES; i++) {
+    if (lane.st[i] == State::RUNNING) return true;
   }
+  return false;
+}
 
-  if (st == State::RUNNING) {
-    if (now - last_pulse_seen_ms > NO_PULSE_TIMEOUT_MS) {
-      set_error("Fehler: Keine Impulse. Sensor/Band pruefen.");
-      return;
+static void show_done(uint8_t i)
+{
+  done_lane = i;
+  lv_label_set_text_fmt(lbl_done, "Spur %u fertig!\nBitte Band entnehmen.", (unsigned)(i + 1));
+  go(scr_done, LV_SCR_LOAD_ANIM_MOVE_LEFT);
+}
+
+static void process_workflow()
+{
+  sync_count();
+
+  const uint32_t now = millis();
+  for (uint8_t i = 0; i < LANES; i++) {
+    const State st = lane.st[i];
+    if (st != State::RUNNING && st != State::CHANGEOVER) continue;
+
+    if (st == State::RUNNING && lane.ist[i] >= lane.ziel[i]) {
+      const uint32_t hit = LAT_ENABLE ? lat_target_ts(i) : 0;   // before a job rebases the count
+      if (i == JOB_LANE && job_auto && job_n > 0) {
+        advance_job();
+        if (LAT_ENABLE && !lane.motor_on[i]) lat_motor_off(hit);
+        continue;
+      }
+      motorWrite(i, false);
+      if (LAT_ENABLE) lat_motor_off(hit);
+      lane.st[i] = State::DONE;
+      // other lanes keep running; only pop the done screen over the main screen
+      if (lv_scr_act() == scr_main) show_done(i);
+      continue;
+    }
+
+    if (st == State::CHANGEOVER && (int32_t)(now - changeover_until_ms) >= 0) {
+      lane.st[i] = State::RUNNING;
+      motorWrite(i, true);
+      lane.last_pulse_ms[i] = now;
+    }
+
+    if (lane.st[i] == State::RUNNING && now - lane.last_pulse_ms[i] > NO_PULSE_TIMEOUT_MS) {
+      set_error(i, "Fehler: Keine Impulse. Sensor/Band pruefen.");
     }
   }
 
@@ -292,46 +883,91 @@ static void process_workflow()
 }
 
 /* ===================== Callbacks ===================== */
-static void on_start(lv_event_t*)
+static void lane_start(uint8_t i)
 {
-  if (st == State::ERROR) return;
+  if (lane.st[i] == State::ERROR) return;
 
-  if (st == State::DONE) {
-    noInterrupts(); isr_count = 0; interrupts();
-    ist = 0;
-  }
+  if (lane.st[i] == State::DONE) resetCount(i);
 
-  st = State::RUNNING;
-  motorWrite(true);
-  last_pulse_seen_ms = millis();
+  lane.st[i] = State::RUNNING;
+  motorWrite(i, true);
+  lane.last_pulse_ms[i] = millis();
   update_main_ui();
 }
 
-static void on_stop(lv_event_t*)
+static void lane_stop(uint8_t i)
 {
-  motorWrite(false);
-  if (st == State::RUNNING) st = State::STOPPED;
+  motorWrite(i, false);
+  if (lane.st[i] == State::RUNNING || lane.st[i] == State::CHANGEOVER) lane.st[i] = State::STOPPED;
   update_main_ui();
 }
 
-static void on_reset(lv_event_t*)
+static void lane_reset(uint8_t i)
 {
-  motorWrite(false);
-  noInterrupts(); isr_count = 0; interrupts();
-  ist = 0;
-  st = State::IDLE;
+  motorWrite(i, false);
+  resetCount(i);
+  lane.st[i] = State::IDLE;
   update_main_ui();
 }
 
+static void on_start(lv_event_t*) { lane_start(sel); }
+static void on_stop(lv_event_t*)  { lane_stop(sel); }
+static void on_reset(lv_event_t*) { lane_reset(sel); }
+
+/* Routes the encoder lane's input pin either to the pulse ISR or to PCNT */
+static void apply_count_mode()
+{
+  if (len_mode) {
+    detachInterrupt((int)ENC_PIN_A);
+    enc_begin();
+  } else {
+    if (enc_ready) pcnt_counter_pause(ENC_UNIT);
+    if (SENSOR_ACTIVE_LOW) pinMode((int)ENC_PIN_A, INPUT_PULLUP);
+    else                   pinMode((int)ENC_PIN_A, INPUT_PULLDOWN);
+    attachInterruptArg((int)ENC_PIN_A, sensor_isr, (void*)(uintptr_t)ENC_LANE, SENSOR_ACTIVE_LOW ? FALLING : RISING);
+  }
+  resetCount(ENC_LANE);
+  ui_valid = false;
+}
+
+/* Queued jobs store their target in the unit active when they were added;
+   switching STUECK/METER underneath them would turn 120 pieces into 1.20 m. */
+static bool mode_locked()
+{
+  return JOB_LANE == ENC_LANE && job_n > 0;
+}
+
+static void update_mode_btn()
+{
+  lv_label_set_text(lv_obj_get_child(btn_mode, 0), set_len_mode ? "METER" : "STUECK");
+  if (mode_locked()) lv_obj_add_state(btn_mode, LV_STATE_DISABLED);
+  else               lv_obj_clear_state(btn_mode, LV_STATE_DISABLED);
+  lv_label_set_text(lbl_ppm, set_len_mode ? "Impulse/m:" : (mode_locked() ? "Auftraege offen" : ""));
+  if (set_len_mode) lv_obj_clear_flag(ta_ppm, LV_OBJ_FLAG_HIDDEN);
+  else              lv_obj_add_flag(ta_ppm, LV_OBJ_FLAG_HIDDEN);
+}
+
 static void on_open_settings(lv_event_t*)
 {
-  if (st == State::RUNNING) return;
+  if (lane.st[sel] == State::RUNNING || lane.st[sel] == State::CHANGEOVER) return;
 
-  char tmp[16];
-  snprintf(tmp, sizeof(tmp), "%lu", (unsigned long)ziel);
+  char tmp[24];
+  snprintf(tmp, sizeof(tmp), "Einstellungen Spur %u", (unsigned)(sel + 1));
+  lv_label_set_text(lbl_set_title, tmp);
+  fmtQty(tmp, sizeof(tmp), sel, lane.ziel[sel], false);
   lv_textarea_set_text(ta_ziel, tmp);
-  snprintf(tmp, sizeof(tmp), "%u", (unsigned)deb_ms);
+  lv_textarea_set_placeholder_text(ta_ziel, (sel == ENC_LANE && len_mode) ? "Ziel in m" : "Ziel in Stueck");
+  snprintf(tmp, sizeof(tmp), "%u", (unsigned)lane.deb_ms[sel]);
   lv_textarea_set_text(ta_deb, tmp);
+  snprintf(tmp, sizeof(tmp), "%lu", (unsigned long)enc_ppm);
+  lv_textarea_set_text(ta_ppm, tmp);
+
+  // count/length switch only exists for the encoder lane
+  set_len_mode = len_mode;
+  if (sel == ENC_LANE && ENC_USABLE) lv_obj_clear_flag(btn_mode, LV_OBJ_FLAG_HIDDEN);
+  else                               lv_obj_add_flag(btn_mode, LV_OBJ_FLAG_HIDDEN);
+  update_mode_btn();
+  if (sel != ENC_LANE) lv_obj_add_flag(ta_ppm, LV_OBJ_FLAG_HIDDEN);
 
   go(scr_set, LV_SCR_LOAD_ANIM_MOVE_LEFT);
 }
@@ -351,17 +987,38 @@ static void kb_event(lv_event_t* e)
   lv_event_code_t code = lv_event_get_code(e);
 
   if (code == LV_EVENT_READY) {
-    uint32_t new_z = (uint32_t)strtoul(lv_textarea_get_text(ta_ziel), nullptr, 10);
+    // empty target (CLEAR or a unit switch): nothing is applied until one is entered
+    if (lv_textarea_get_text(ta_ziel)[0] == 0) {
+      if (kb) lv_keyboard_set_textarea(kb, ta_ziel);
+      lv_obj_add_state(ta_ziel, LV_STATE_FOCUSED);
+      return;
+    }
+
+    if (sel == ENC_LANE) {
+      uint32_t ppm = (uint32_t)strtoul(lv_textarea_get_text(ta_ppm), nullptr, 10);
+      if (ppm < 1) ppm = 1;
+      if (ppm > 1000000) ppm = 1000000;
+      enc_ppm = ppm;
+      prefs.putUInt(KEY_PPM, enc_ppm);
+
+      if (ENC_USABLE && set_len_mode != len_mode) {
+        len_mode = set_len_mode;
+        prefs.putBool(KEY_LEN, len_mode);
+        apply_count_mode();
+      }
+    }
+
+    // parsed after the mode switch: metres in length mode, pieces otherwise
+    uint32_t new_z = parseZiel(sel, lv_textarea_get_text(ta_ziel));
     uint32_t new_d = (uint32_t)strtoul(lv_textarea_get_text(ta_deb), nullptr, 10);
 
-    if (new_z < 1) new_z = 1;
-    if (new_z > 999999) new_z = 999999;
     if (new_d < 1) new_d = 1;
     if (new_d > 100) new_d = 100;
 
-    ziel = new_z;
-    deb_ms = (uint16_t)new_d;
-    saveSettings();
+    lane.ziel[sel] = new_z;
+    if (sel == JOB_LANE) ziel_from_job = false;   // confirmed by the operator
+    setDebounce(sel, (uint16_t)new_d);
+    saveSettings(sel);
 
     go(scr_main, LV_SCR_LOAD_ANIM_MOVE_RIGHT);
     update_main_ui();
@@ -373,25 +1030,356 @@ static void kb_event(lv_event_t* e)
   }
 }
 
+static void update_jobs_ui()
+{
+  char buf[MAX_JOBS * 48 + 1], z[20];
+  size_t n = 0;
+  buf[0] = 0;
+  if (job_n == 0) snprintf(buf, sizeof(buf), "Keine Auftraege");
+  for (uint8_t i = 0; i < job_n && n < sizeof(buf); i++) {
+    fmtQty(z, sizeof(z), JOB_LANE, jobs[i].ziel, true);
+    n += snprintf(buf + n, sizeof(buf) - n, "%u. %s  Ziel %s  Pause %us\n",
+                  (unsigned)(i + 1), jobs[i].label[0] ? jobs[i].label : "-",
+                  z, (unsigned)jobs[i].delay_s);
+  }
+  lv_label_set_text(lbl_jobs, buf);
+  lv_label_set_text(lbl_job_auto, job_auto ? "AUTO: AN" : "AUTO: AUS");
+}
+
+static void on_open_jobs(lv_event_t*)
+{
+  char tmp[16];
+  fmtQty(tmp, sizeof(tmp), JOB_LANE, lane.ziel[JOB_LANE], false);
+  lv_textarea_set_text(ta_job_ziel, tmp);
+  lv_textarea_set_text(ta_job_delay, "0");
+  lv_textarea_set_text(ta_job_label, "");
+  update_jobs_ui();
+  go(scr_jobs, LV_SCR_LOAD_ANIM_MOVE_LEFT);
+}
+
+static void on_job_add(lv_event_t*)
+{
+  if (job_n >= MAX_JOBS) return;
+
+  uint32_t z = parseZiel(JOB_LANE, lv_textarea_get_text(ta_job_ziel));
+  uint32_t d = (uint32_t)strtoul(lv_textarea_get_text(ta_job_delay), nullptr, 10);
+  if (d > MAX_JOB_DELAY_S) d = MAX_JOB_DELAY_S;
+
+  Job& j = jobs[job_n++];
+  j.ziel = z;
+  j.delay_s = (uint16_t)d;
+  strncpy(j.label, lv_textarea_get_text(ta_job_label), sizeof(j.label) - 1);
+  j.label[sizeof(j.label) - 1] = 0;
+
+  jobs_dirty = true;
+  lv_textarea_set_text(ta_job_label, "");
+  update_jobs_ui();
+}
+
+static void on_job_del(lv_event_t*)
+{
+  // removes the last queued job
+  if (job_n == 0) return;
+  job_n--;
+  jobs_dirty = true;
+  update_jobs_ui();
+}
+
+static void on_job_auto(lv_event_t*)
+{
+  job_auto = !job_auto;
+  jobs_dirty = true;
+  update_jobs_ui();
+}
+
+static void kb_job_event(lv_event_t* e)
+{
+  lv_event_code_t code = lv_event_get_code(e);
+  if (code == LV_EVENT_READY) on_job_add(nullptr);
+  if (code == LV_EVENT_CANCEL) {
+    go(scr_main, LV_SCR_LOAD_ANIM_MOVE_RIGHT);
+    update_main_ui();
+  }
+}
+
+/* ===================== Modbus model =====================
+   Per lane a block of MB_LANE_REGS holding registers (FC03/04/06/16) and
+   MB_LANE_COILS coils (FC01/05/15), lane n at n * block size:
+     reg 0/1  ist  (hi/lo)          coil 0  START (reads 1 while running)
+     reg 2/3  ziel (hi/lo), r/w     coil 1  STOP  (reads 1 while stopped)
+     reg 4    deb_ms, r/w           coil 2  RESET (reads 0)
+     reg 5    State, reg 6 motor, reg 7 length mode (ist/ziel in cm)
+   The Modbus task only sees mb_image (refreshed by the control loop) and
+   posts writes to mb_cmdq, which loop() applies. A 32-bit ziel commits on
+   its lo word; FC16 over regs 2..3 writes both at once. */
+static constexpr uint16_t MB_LANE_REGS  = 8;
+static constexpr uint16_t MB_LANE_COILS = 8;
+
+enum class MbOp : uint8_t { START, STOP, RESET, ZIEL, DEB };
+struct MbCmd { MbOp op; uint8_t lane; uint32_t val; };
+
+static uint16_t mb_image[LANES * MB_LANE_REGS];
+static portMUX_TYPE mb_mux = portMUX_INITIALIZER_UNLOCKED;
+static QueueHandle_t mb_cmdq = nullptr;
+static uint16_t mb_ziel_hi[LANES];   // Modbus task only
+
+static void mb_publish()
+{
+  uint16_t img[LANES * MB_LANE_REGS];
+  for (uint8_t i = 0; i < LANES; i++) {
+    uint16_t* r = &img[i * MB_LANE_REGS];
+    r[0] = lane.ist[i] >> 16;
+    r[1] = lane.ist[i] & 0xFFFF;
+    r[2] = lane.ziel[i] >> 16;
+    r[3] = lane.ziel[i] & 0xFFFF;
+    r[4] = lane.deb_ms[i];
+    r[5] = (uint16_t)lane.st[i];
+    r[6] = lane.motor_on[i] ? 1 : 0;
+    r[7] = (i == ENC_LANE && len_mode) ? 1 : 0;
+  }
+  portENTER_CRITICAL(&mb_mux);
+  memcpy(mb_image, img, sizeof(img));
+  portEXIT_CRITICAL(&mb_mux);
+}
+
+static uint8_t mb_post(MbOp op, uint8_t i, uint32_t val)
+{
+  const MbCmd c{ op, i, val };
+  return xQueueSend(mb_cmdq, &c, 0) == pdTRUE ? MB_EX_NONE : MB_EX_BUSY;
+}
+
+static uint8_t mb_read_regs(uint16_t addr, uint16_t n, uint16_t* out)
+{
+  if ((uint32_t)addr + n > LANES * MB_LANE_REGS) return MB_EX_ILLEGAL_ADDR;
+  portENTER_CRITICAL(&mb_mux);
+  memcpy(out, &mb_image[addr], n * sizeof(uint16_t));
+  portEXIT_CRITICAL(&mb_mux);
+  return MB_EX_NONE;
+}
+
+static uint8_t mb_write_regs(uint16_t addr, uint16_t n, const uint8_t* words)
+{
+  if ((uint32_t)addr + n > LANES * MB_LANE_REGS) return MB_EX_ILLEGAL_ADDR;
+
+  for (uint16_t k = 0; k < n; k++) {
+    const uint8_t  i = (addr + k) / MB_LANE_REGS;
+    const uint16_t v = (uint16_t)((words[k * 2] << 8) | words[k * 2 + 1]);
+    uint8_t ex = MB_EX_NONE;
+
+    switch ((addr + k) % MB_LANE_REGS) {
+      case 2:
+        mb_ziel_hi[i] = v;
+        break;
+      case 3: {
+        const uint32_t z = ((uint32_t)mb_ziel_hi[i] << 16) | v;
+        if (z < 1 || z > 999999) return MB_EX_ILLEGAL_VALUE;
+        ex = mb_post(MbOp::ZIEL, i, z);
+        break;
+      }
+      case 4:
+        if (v < 1 || v > 100) return MB_EX_ILLEGAL_VALUE;
+        ex = mb_post(MbOp::DEB, i, v);
+        break;
+      default:
+        return MB_EX_ILLEGAL_ADDR;   // read-only
+    }
+    if (ex) return ex;
+  }
+  return MB_EX_NONE;
+}
+
+static uint8_t mb_read_coils(uint16_t addr, uint16_t n, uint8_t* bits)
+{
+  if ((uint32_t)addr + n > LANES * MB_LANE_COILS) return MB_EX_ILLEGAL_ADDR;
+
+  portENTER_CRITICAL(&mb_mux);
+  for (uint16_t k = 0; k < n; k++) {
+    const uint8_t i = (addr + k) / MB_LANE_COILS;
+    const State st = (State)mb_image[i * MB_LANE_REGS + 5];
+    bool on = false;
+    switch ((addr + k) % MB_LANE_COILS) {
+      case 0: on = (st == State::RUNNING); break;
+      case 1: on = (st == State::STOPPED); break;
+    }
+    if (on) bits[k / 8] |= (uint8_t)(1 << (k % 8));
+  }
+  portEXIT_CRITICAL(&mb_mux);
+  return MB_EX_NONE;
+}
+
+static uint8_t mb_write_coils(uint16_t addr, uint16_t n, const uint8_t* bits)
+{
+  if ((uint32_t)addr + n > LANES * MB_LANE_COILS) return MB_EX_ILLEGAL_ADDR;
+
+  for (uint16_t k = 0; k < n; k++) {
+    if (!(bits[k / 8] & (1 << (k % 8)))) continue;   // only ON triggers a command
+    const uint8_t i = (addr + k) / MB_LANE_COILS;
+    uint8_t ex = MB_EX_NONE;
+    switch ((addr + k) % MB_LANE_COILS) {
+      case 0: ex = mb_post(MbOp::START, i, 0); break;
+      case 1: ex = mb_post(MbOp::STOP,  i, 0); break;
+      case 2: ex = mb_post(MbOp::RESET, i, 0); break;
+      default: return MB_EX_ILLEGAL_ADDR;
+    }
+    if (ex) return ex;
+  }
+  return MB_EX_NONE;
+}
+
+/* loop() side: applies what the Modbus task queued */
+static void mb_apply()
+{
+  if (!mb_cmdq) return;
+
+  MbCmd c;
+  while (xQueueReceive(mb_cmdq, &c, 0) == pdTRUE) {
+    switch (c.op) {
+      case MbOp::START: lane_start(c.lane); break;
+      case MbOp::STOP:  lane_stop(c.lane);  break;
+      case MbOp::RESET: lane_reset(c.lane); break;
+      case MbOp::ZIEL:
+        lane.ziel[c.lane] = c.val;
+        if (c.lane == JOB_LANE) ziel_from_job = false;
+        saveSettings(c.lane);
+        update_main_ui();
+        break;
+      case MbOp::DEB:
+        setDebounce(c.lane, (uint16_t)c.val);
+        saveSettings(c.lane);
+        break;
+    }
+  }
+}
+
+/* ===================== Telemetry ===================== */
+static uint32_t loop_sum_us = 0;
+static uint32_t loop_max_us = 0;
+static uint32_t loop_n = 0;
+
+static void tel_emit(uint32_t now)
+{
+  static uint32_t last_ms = 0;
+  static uint32_t last_ist[LANES] = {0};
+  static uint16_t seq = 0;
+
+  const uint32_t dt = now - last_ms;
+  last_ms = now;
+
+  TelRecord r = {};
+  r.t_ms        = now;
+  r.loop_avg_us = (uint16_t)(loop_n ? loop_sum_us / loop_n : 0);
+  r.loop_max_us = (uint16_t)(loop_max_us > 0xFFFF ? 0xFFFF : loop_max_us);
+  r.heap_free   = ESP.getFreeHeap();
+  r.dropped     = tel_dropped();
+  loop_sum_us = loop_max_us = loop_n = 0;
+
+  for (uint8_t i = 0; i < LANES; i++) {
+    const uint32_t ist = lane.ist[i];
+    const uint32_t d = (ist >= last_ist[i]) ? ist - last_ist[i] : 0;   // reset => no rate
+    last_ist[i] = ist;
+
+    r.seq     = seq++;
+    r.lane    = i;
+    r.state   = (uint8_t)lane.st[i];
+    r.motor   = lane.motor_on[i] ? 1 : 0;
+    r.flags   = (i == ENC_LANE && len_mode) ? 1 : 0;
+    r.count   = ist;
+    r.rate_pm = dt ? (uint32_t)((uint64_t)d * 60000ULL / dt) : 0;
+    tel_push(r);
+  }
+}
+
+/* ===================== Diagnostics ===================== */
+static int fmt_lat(char* buf, size_t n, const char* name, const LatStat& s)
+{
+  if (s.n == 0) return snprintf(buf, n, "%s:  -\n", name);
+  return snprintf(buf, n, "%s:  min %.1f  avg %.1f  p99 %.1f  max %.1f ms  (n=%lu)\n", name,
+                  s.min_us / 1000.0f, s.avg_us() / 1000.0f, s.percentile_us(990) / 1000.0f,
+                  s.max_us / 1000.0f, (unsigned long)s.n);
+}
+
+static void update_diag_ui()
+{
+  char buf[640];
+  size_t n = 0;
+  buf[0] = 0;
+  if (LAT_ENABLE) {
+    n += fmt_lat(buf + n, sizeof(buf) - n, "Impuls -> Zaehler", lat_sync);
+    n += fmt_lat(buf + n, sizeof(buf) - n, "Impuls -> Text", lat_ui);
+    n += fmt_lat(buf + n, sizeof(buf) - n, "Impuls -> Anzeige", lat_disp);
+    n += fmt_lat(buf + n, sizeof(buf) - n, "Impuls -> Motor AUS", lat_motor);
+    const float hz = PANEL_TIMING.refresh_hz(SCREEN_W, SCREEN_H);
+    if (n < sizeof(buf)) {
+      n += snprintf(buf + n, sizeof(buf) - n, "\nAnzeige = im Bildspeicher; Scan-out danach bis %.0f ms (%.1f Hz)\nSpur %u\n",
+                    1000.0f / hz, hz, (unsigned)(sel + 1));
+    }
+  }
+  if (MB_ENABLE && n < sizeof(buf)) {
+    const MbStats s = mb_stats();
+    snprintf(buf + n, sizeof(buf) - n, "\nModbus: Rahmen %lu  Antworten %lu  Fehler %lu",
+             (unsigned long)s.rx, (unsigned long)s.tx, (unsigned long)s.err);
+  }
+  set_text_if_changed(lbl_diag, buf);
+}
+
+static void lat_print()
+{
+  const char* keys[] = { "sync", "ui", "disp", "motor" };
+  const LatStat* st[] = { &lat_sync, &lat_ui, &lat_disp, &lat_motor };
+  for (uint8_t k = 0; k < 4; k++) {
+    const LatStat& s = *st[k];
+    Serial.printf("LAT %-5s n=%lu min=%.1f avg=%.1f p99=%.1f max=%.1f ms\n", keys[k], (unsigned long)s.n,
+                  s.n ? s.min_us / 1000.0f : 0.0f, s.avg_us() / 1000.0f,
+                  s.percentile_us(990) / 1000.0f, s.max_us / 1000.0f);
+  }
+}
+
 /* ===================== Screens ===================== */
 static void build_main()
 {
   scr_main = lv_obj_create(nullptr);
   style_screen(scr_main);
 
-  make_header(scr_main, "Bandware Zaehler", "IST / Ziel + Start/Stop/Reset");
+  lv_obj_t* head = make_header(scr_main, "Bandware Zaehler", "IST / Ziel + Start/Stop/Reset");
+  if (DIAG_ENABLE) {
+    // service entry: long-press the title bar
+    lv_obj_add_event_cb(head, [](lv_event_t*){
+      update_diag_ui();
+      go(scr_diag, LV_SCR_LOAD_ANIM_MOVE_LEFT);
+    }, LV_EVENT_LONG_PRESSED, nullptr);
+  }
+
+  // Lane tiles: tap to select the lane shown below and driven by the buttons
+  const int tgap = UI::TILE_GAP;
+  const int tw = (UI::CONTENT_W - tgap * (LANES - 1)) / LANES;
+  for (uint8_t i = 0; i < LANES; i++) {
+    lv_obj_t* t = make_btn_outline(scr_main, "", tw, UI::TILE_H);
+    lv_obj_align(t, LV_ALIGN_TOP_LEFT, UI::MARGIN + i * (tw + tgap), UI::TILE_Y);
+    lv_obj_set_style_radius(t, 12, 0);
+    lv_obj_set_style_border_width(t, i == sel ? 4 : 1, 0);
+    lbl_lane[i] = lv_obj_get_child(t, 0);
+    lv_obj_set_width(lbl_lane[i], tw - 2 * UI::sx(12));   // clear of the rounded border
+    lv_label_set_long_mode(lbl_lane[i], LV_LABEL_LONG_DOT);
+    lv_obj_set_style_text_align(lbl_lane[i], LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_style_text_font(lbl_lane[i], F16, 0);
+    lv_obj_set_style_text_color(lbl_lane[i], C_BLACK, 0);
+    lv_obj_add_event_cb(t, [](lv_event_t* e){
+      select_lane((uint8_t)(uintptr_t)lv_event_get_user_data(e));
+    }, LV_EVENT_CLICKED, (void*)(uintptr_t)i);
+    btn_lane[i] = t;
+  }
 
   lv_obj_t* frame = lv_obj_create(scr_main);
-  lv_obj_set_size(frame, 780, 300);
-  lv_obj_align(frame, LV_ALIGN_TOP_MID, 0, 78);
+  lv_obj_set_size(frame, UI::CONTENT_W, UI::FRAME_H);
+  lv_obj_align(frame, LV_ALIGN_TOP_MID, 0, UI::FRAME_Y);
   lv_obj_set_style_radius(frame, 18, 0);
   lv_obj_set_style_border_width(frame, 2, 0);
   lv_obj_set_style_border_color(frame, C_ORANGE, 0);
-  lv_obj_set_style_pad_all(frame, 16, 0);
+  lv_obj_set_style_pad_all(frame, UI::FRAME_PAD, 0);
 
   // IST
   lv_obj_t* col_ist = lv_obj_create(frame);
-  lv_obj_set_size(col_ist, 360, 185);
+  lv_obj_set_size(col_ist, UI::sx(360), UI::COL_H);
   lv_obj_align(col_ist, LV_ALIGN_TOP_LEFT, 0, 0);
   lv_obj_set_style_bg_opa(col_ist, LV_OPA_TRANSP, 0);
   lv_obj_set_style_border_width(col_ist, 0, 0);
@@ -406,11 +1394,11 @@ static void build_main()
   lv_label_set_text(lbl_ist_big, "0");
   lv_obj_set_style_text_font(lbl_ist_big, F48, 0);
   lv_obj_set_style_text_color(lbl_ist_big, C_ORANGE, 0);
-  lv_obj_align(lbl_ist_big, LV_ALIGN_TOP_LEFT, 0, 55);
+  lv_obj_align(lbl_ist_big, LV_ALIGN_TOP_LEFT, 0, UI::BIG_Y);
 
   // ZIEL (big)
   lv_obj_t* col_z = lv_obj_create(frame);
-  lv_obj_set_size(col_z, 380, 185);
+  lv_obj_set_size(col_z, UI::sx(380), UI::COL_H);
   lv_obj_align(col_z, LV_ALIGN_TOP_RIGHT, 0, 0);
   lv_obj_set_style_bg_opa(col_z, LV_OPA_TRANSP, 0);
   lv_obj_set_style_border_width(col_z, 0, 0);
@@ -425,12 +1413,12 @@ static void build_main()
   lv_label_set_text(lbl_ziel_big, "120");
   lv_obj_set_style_text_font(lbl_ziel_big, F48, 0);
   lv_obj_set_style_text_color(lbl_ziel_big, C_BLACK, 0);
-  lv_obj_align(lbl_ziel_big, LV_ALIGN_TOP_LEFT, 0, 55);
+  lv_obj_align(lbl_ziel_big, LV_ALIGN_TOP_LEFT, 0, UI::BIG_Y);
 
   // Progress
   bar = lv_bar_create(frame);
-  lv_obj_set_size(bar, 748, 28);
-  lv_obj_align(bar, LV_ALIGN_BOTTOM_MID, 0, -52);
+  lv_obj_set_size(bar, UI::FRAME_IN_W, UI::sy(28));
+  lv_obj_align(bar, LV_ALIGN_BOTTOM_MID, 0, -UI::sy(52));
   lv_bar_set_range(bar, 0, 100);
   lv_obj_set_style_bg_color(bar, C_GRAY, LV_PART_MAIN);
   lv_obj_set_style_bg_opa(bar, LV_OPA_20, LV_PART_MAIN);
@@ -440,19 +1428,21 @@ static void build_main()
   lbl_status = lv_label_create(frame);
   lv_label_set_text(lbl_status, "Status: Bereit");
   lv_obj_set_style_text_font(lbl_status, F24, 0);
-  lv_obj_align(lbl_status, LV_ALIGN_BOTTOM_LEFT, 0, -10);
+  lv_obj_set_width(lbl_status, UI::FRAME_IN_W);
+  lv_label_set_long_mode(lbl_status, LV_LABEL_LONG_DOT);   // a long job name must not leave the frame
+  lv_obj_align(lbl_status, LV_ALIGN_BOTTOM_LEFT, 0, -UI::sy(10));
 
   // Bottom buttons row
   lv_obj_t* bottom = lv_obj_create(scr_main);
-  lv_obj_set_size(bottom, 800, 92);
+  lv_obj_set_size(bottom, SCREEN_W, UI::ROW_H);
   lv_obj_align(bottom, LV_ALIGN_BOTTOM_MID, 0, 0);
   lv_obj_set_style_bg_opa(bottom, LV_OPA_TRANSP, 0);
   lv_obj_set_style_border_width(bottom, 0, 0);
-  lv_obj_set_style_pad_all(bottom, 10, 0);
+  lv_obj_set_style_pad_all(bottom, UI::MARGIN, 0);
 
-  const int bw = 185;
-  const int bh = 72;
-  const int gap = 10;
+  const int bw = UI::BTN_W;
+  const int bh = UI::BTN_H;
+  const int gap = UI::GAP;
 
   lv_obj_t* bstart = make_btn_fill(bottom, "START", bw, bh, C_ORANGE, C_WHITE);
   lv_obj_align(bstart, LV_ALIGN_LEFT_MID, 0, 0);
@@ -469,6 +1459,10 @@ static void build_main()
   lv_obj_t* bset = make_btn_fill(bottom, "EINSTELL.", bw, bh, C_ORANGE, C_WHITE);
   lv_obj_align(bset, LV_ALIGN_LEFT_MID, (bw + gap) * 3, 0);
   lv_obj_add_event_cb(bset, on_open_settings, LV_EVENT_CLICKED, nullptr);
+
+  lv_obj_t* bjobs = make_btn_outline(bottom, "AUFTR.", bw, bh);
+  lv_obj_align(bjobs, LV_ALIGN_LEFT_MID, (bw + gap) * 4, 0);
+  lv_obj_add_event_cb(bjobs, on_open_jobs, LV_EVENT_CLICKED, nullptr);
 }
 
 static void build_settings()
@@ -476,15 +1470,16 @@ static void build_settings()
   scr_set = lv_obj_create(nullptr);
   style_screen(scr_set);
 
-  make_header(scr_set, "Einstellungen", "Ziel und Entprellung setzen und speichern");
+  lv_obj_t* head = make_header(scr_set, "Einstellungen", "Ziel und Entprellung setzen und speichern");
+  lbl_set_title = lv_obj_get_child(head, 0);
 
   lv_obj_t* card = lv_obj_create(scr_set);
-  lv_obj_set_size(card, 780, 250);
-  lv_obj_align(card, LV_ALIGN_TOP_MID, 0, 78);
+  lv_obj_set_size(card, UI::CONTENT_W, UI::sy(250));
+  lv_obj_align(card, LV_ALIGN_TOP_MID, 0, UI::HEADER_H + UI::sy(8));
   lv_obj_set_style_radius(card, 18, 0);
   lv_obj_set_style_border_width(card, 2, 0);
   lv_obj_set_style_border_color(card, C_ORANGE, 0);
-  lv_obj_set_style_pad_all(card, 18, 0);
+  lv_obj_set_style_pad_all(card, UI::sx(18), 0);
 
   // Ziel + CLEAR (ONLY HERE)
   lv_obj_t* l1 = lv_label_create(card);
@@ -493,37 +1488,68 @@ static void build_settings()
   lv_obj_align(l1, LV_ALIGN_TOP_LEFT, 0, 0);
 
   ta_ziel = lv_textarea_create(card);
-  lv_obj_set_size(ta_ziel, 420, 60);
-  lv_obj_align(ta_ziel, LV_ALIGN_TOP_LEFT, 0, 45);
+  lv_obj_set_size(ta_ziel, UI::sx(420), UI::FIELD_H);
+  lv_obj_align(ta_ziel, LV_ALIGN_TOP_LEFT, 0, UI::sy(45));
   lv_textarea_set_one_line(ta_ziel, true);
   lv_obj_set_style_text_font(ta_ziel, F24, 0);
 
-  btn_clear = make_btn_fill(card, "CLEAR", 150, 60, C_RED, C_WHITE);
-  lv_obj_align(btn_clear, LV_ALIGN_TOP_RIGHT, 0, 45);
+  btn_clear = make_btn_fill(card, "CLEAR", UI::sx(150), UI::FIELD_H, C_RED, C_WHITE);
+  lv_obj_align(btn_clear, LV_ALIGN_TOP_RIGHT, 0, UI::sy(45));
   lv_obj_add_event_cb(btn_clear, [](lv_event_t*){ on_clear_in_settings(nullptr); }, LV_EVENT_CLICKED, nullptr);
 
   // Debounce
   lv_obj_t* l2 = lv_label_create(card);
   lv_label_set_text(l2, "Entprellung (ms):");
   lv_obj_set_style_text_font(l2, F24, 0);
-  lv_obj_align(l2, LV_ALIGN_TOP_LEFT, 0, 120);
+  lv_obj_align(l2, LV_ALIGN_TOP_LEFT, 0, UI::sy(120));
 
   ta_deb = lv_textarea_create(card);
-  lv_obj_set_size(ta_deb, 420, 60);
-  lv_obj_align(ta_deb, LV_ALIGN_TOP_LEFT, 0, 165);
+  lv_obj_set_size(ta_deb, UI::sx(420), UI::FIELD_H);
+  lv_obj_align(ta_deb, LV_ALIGN_TOP_LEFT, 0, UI::sy(165));
   lv_textarea_set_one_line(ta_deb, true);
   lv_obj_set_style_text_font(ta_deb, F24, 0);
 
+  // Count mode (encoder lane only) + encoder scale
+  btn_mode = make_btn_outline(card, "STUECK", UI::sx(140), UI::FIELD_H);
+  lv_obj_align(btn_mode, LV_ALIGN_TOP_LEFT, UI::sx(435), UI::sy(165));
+  lv_obj_set_style_opa(btn_mode, LV_OPA_50, LV_STATE_DISABLED);
+  lv_obj_add_event_cb(btn_mode, [](lv_event_t*){
+    if (mode_locked()) return;
+    set_len_mode = !set_len_mode;
+
+    // pieces and metres don't convert: back in the stored unit the stored
+    // target returns, otherwise the field is cleared and OK waits for input
+    char tmp[16] = "";
+    if (set_len_mode == len_mode) fmtQty(tmp, sizeof(tmp), sel, lane.ziel[sel], false);
+    lv_textarea_set_text(ta_ziel, tmp);
+    lv_textarea_set_placeholder_text(ta_ziel, set_len_mode ? "Ziel in m" : "Ziel in Stueck");
+    if (kb) lv_keyboard_set_textarea(kb, ta_ziel);
+    lv_obj_add_state(ta_ziel, LV_STATE_FOCUSED);
+    update_mode_btn();
+  }, LV_EVENT_CLICKED, nullptr);
+
+  lbl_ppm = lv_label_create(card);
+  lv_label_set_text(lbl_ppm, "");
+  lv_obj_set_style_text_font(lbl_ppm, F24, 0);
+  lv_obj_align(lbl_ppm, LV_ALIGN_TOP_LEFT, UI::sx(590), UI::sy(120));
+
+  ta_ppm = lv_textarea_create(card);
+  lv_obj_set_size(ta_ppm, UI::sx(150), UI::FIELD_H);
+  lv_obj_align(ta_ppm, LV_ALIGN_TOP_RIGHT, 0, UI::sy(165));
+  lv_textarea_set_one_line(ta_ppm, true);
+  lv_obj_set_style_text_font(ta_ppm, F24, 0);
+
   // Keyboard
   kb = lv_keyboard_create(scr_set);
   lv_keyboard_set_mode(kb, LV_KEYBOARD_MODE_NUMBER);
-  lv_obj_set_size(kb, 780, 180);
+  lv_obj_set_size(kb, UI::CONTENT_W, UI::sy(180));
   lv_obj_align(kb, LV_ALIGN_BOTTOM_MID, 0, 0);
   lv_obj_add_event_cb(kb, kb_event, LV_EVENT_ALL, nullptr);
   lv_keyboard_set_textarea(kb, ta_ziel);
 
   lv_obj_add_event_cb(ta_ziel, [](lv_event_t*){ lv_keyboard_set_textarea(kb, ta_ziel); }, LV_EVENT_FOCUSED, nullptr);
   lv_obj_add_event_cb(ta_deb,  [](lv_event_t*){ lv_keyboard_set_textarea(kb, ta_deb ); }, LV_EVENT_FOCUSED, nullptr);
+  lv_obj_add_event_cb(ta_ppm,  [](lv_event_t*){ lv_keyboard_set_textarea(kb, ta_ppm ); }, LV_EVENT_FOCUSED, nullptr);
 }
 
 static void build_done()
@@ -534,8 +1560,8 @@ static void build_done()
   make_header(scr_done, "Fertig", "Ziel erreicht: Motor AUS, Band entnehmen");
 
   lv_obj_t* card = lv_obj_create(scr_done);
-  lv_obj_set_size(card, 780, 260);
-  lv_obj_align(card, LV_ALIGN_CENTER, 0, 10);
+  lv_obj_set_size(card, UI::CONTENT_W, UI::sy(260));
+  lv_obj_align(card, LV_ALIGN_CENTER, 0, UI::sy(10));
   lv_obj_set_style_radius(card, 18, 0);
   lv_obj_set_style_bg_color(card, C_ORANGE, 0);
   lv_obj_set_style_bg_opa(card, LV_OPA_COVER, 0);
@@ -547,10 +1573,12 @@ static void build_done()
   lv_obj_set_style_text_font(lbl_done, F24, 0);
   lv_obj_center(lbl_done);
 
-  lv_obj_t* btn_ok = make_btn_outline(scr_done, "OK", 300, 70);
-  lv_obj_align(btn_ok, LV_ALIGN_BOTTOM_MID, 0, -20);
+  lv_obj_t* btn_ok = make_btn_outline(scr_done, "OK", UI::sx(300), UI::sy(70));
+  lv_obj_align(btn_ok, LV_ALIGN_BOTTOM_MID, 0, -UI::sy(20));
   lv_obj_add_event_cb(btn_ok, [](lv_event_t*){
-    st = State::IDLE;
+    lane.st[done_lane] = State::IDLE;
+    // arm the next batch from zero, START runs it (IDLE, so lane_start() won't reset)
+    if (done_lane == JOB_LANE && job_n > 0) take_next_job(UINT32_MAX);
     go(scr_main, LV_SCR_LOAD_ANIM_MOVE_RIGHT);
     update_main_ui();
   }, LV_EVENT_CLICKED, nullptr);
@@ -564,8 +1592,8 @@ static void build_error()
   make_header(scr_err, "Fehler", "Failsafe: Motor AUS. Ursache pruefen und Reset");
 
   lv_obj_t* card = lv_obj_create(scr_err);
-  lv_obj_set_size(card, 780, 260);
-  lv_obj_align(card, LV_ALIGN_CENTER, 0, 10);
+  lv_obj_set_size(card, UI::CONTENT_W, UI::sy(260));
+  lv_obj_align(card, LV_ALIGN_CENTER, 0, UI::sy(10));
   lv_obj_set_style_radius(card, 18, 0);
   lv_obj_set_style_bg_color(card, C_RED, 0);
   lv_obj_set_style_bg_opa(card, LV_OPA_COVER, 0);
@@ -577,14 +1605,129 @@ static void build_error()
   lv_obj_set_style_text_font(lbl_err, F24, 0);
   lv_obj_center(lbl_err);
 
-  lv_obj_t* btn_r = make_btn_outline(scr_err, "RESET", 300, 70);
-  lv_obj_align(btn_r, LV_ALIGN_BOTTOM_MID, 0, -20);
+  lv_obj_t* btn_r = make_btn_outline(scr_err, "RESET", UI::sx(300), UI::sy(70));
+  lv_obj_align(btn_r, LV_ALIGN_BOTTOM_MID, 0, -UI::sy(20));
   lv_obj_add_event_cb(btn_r, [](lv_event_t*){
-    motorWrite(false);
+    motorWrite(err_lane, false);
     err_msg[0] = 0;
-    st = State::IDLE;
-    noInterrupts(); isr_count = 0; interrupts();
-    ist = 0;
+    lane.st[err_lane] = State::IDLE;
+    resetCount(err_lane);
+    go(scr_main, LV_SCR_LOAD_ANIM_MOVE_RIGHT);
+    update_main_ui();
+  }, LV_EVENT_CLICKED, nullptr);
+}
+
+static void build_jobs()
+{
+  scr_jobs = lv_obj_create(nullptr);
+  style_screen(scr_jobs);
+
+  make_header(scr_jobs, "Auftraege", "Warteschlange: Ziel, Bezeichnung, Pause vor Auto-Start");
+
+  lv_obj_t* card = lv_obj_create(scr_jobs);
+  lv_obj_set_size(card, UI::CONTENT_W, UI::sy(236));
+  lv_obj_align(card, LV_ALIGN_TOP_MID, 0, UI::CARD_Y);
+  lv_obj_set_style_radius(card, 18, 0);
+  lv_obj_set_style_border_width(card, 2, 0);
+  lv_obj_set_style_border_color(card, C_ORANGE, 0);
+  lv_obj_set_style_pad_all(card, UI::sx(12), 0);
+
+  const char* caps[3] = { "Ziel:", "Pause (s):", "Name:" };
+  lv_obj_t** tas[3]   = { &ta_job_ziel, &ta_job_delay, &ta_job_label };
+  for (int i = 0; i < 3; i++) {
+    lv_obj_t* l = lv_label_create(card);
+    lv_label_set_text(l, caps[i]);
+    lv_obj_set_style_text_font(l, F24, 0);
+    lv_obj_align(l, LV_ALIGN_TOP_LEFT, 0, i * UI::sy(52) + UI::sy(12));
+
+    lv_obj_t* ta = lv_textarea_create(card);
+    lv_obj_set_size(ta, UI::sx(230), UI::sy(44));
+    lv_obj_align(ta, LV_ALIGN_TOP_LEFT, UI::sx(120), i * UI::sy(52));
+    lv_textarea_set_one_line(ta, true);
+    lv_obj_set_style_text_font(ta, F24, 0);
+    *tas[i] = ta;
+  }
+  lv_textarea_set_max_length(ta_job_label, sizeof(Job::label) - 1);
+
+  lv_obj_t* badd = make_btn_fill(card, "+ AUFTRAG", UI::sx(170), UI::sy(44), C_ORANGE, C_WHITE);
+  lv_obj_align(badd, LV_ALIGN_TOP_LEFT, 0, UI::sy(160));
+  lv_obj_add_event_cb(badd, on_job_add, LV_EVENT_CLICKED, nullptr);
+
+  lv_obj_t* bdel = make_btn_fill(card, "ENTF.", UI::sx(170), UI::sy(44), C_RED, C_WHITE);
+  lv_obj_align(bdel, LV_ALIGN_TOP_LEFT, UI::sx(180), UI::sy(160));
+  lv_obj_add_event_cb(bdel, on_job_del, LV_EVENT_CLICKED, nullptr);
+
+  lbl_jobs = lv_label_create(card);
+  lv_obj_set_width(lbl_jobs, UI::sx(370));
+  lv_obj_align(lbl_jobs, LV_ALIGN_TOP_LEFT, UI::sx(380), 0);
+  lv_label_set_long_mode(lbl_jobs, LV_LABEL_LONG_CLIP);
+  lv_obj_set_height(lbl_jobs, UI::sy(150));
+
+  lv_obj_t* bauto = make_btn_outline(card, "AUTO: AUS", UI::sx(180), UI::sy(44));
+  lv_obj_align(bauto, LV_ALIGN_TOP_LEFT, UI::sx(380), UI::sy(160));
+  lbl_job_auto = lv_obj_get_child(bauto, 0);
+  lv_obj_add_event_cb(bauto, on_job_auto, LV_EVENT_CLICKED, nullptr);
+
+  lv_obj_t* bback = make_btn_outline(card, "ZURUECK", UI::sx(170), UI::sy(44));
+  lv_obj_align(bback, LV_ALIGN_TOP_RIGHT, 0, UI::sy(160));
+  lv_obj_add_event_cb(bback, [](lv_event_t*){
+    go(scr_main, LV_SCR_LOAD_ANIM_MOVE_RIGHT);
+    update_main_ui();
+  }, LV_EVENT_CLICKED, nullptr);
+
+  kb_job = lv_keyboard_create(scr_jobs);
+  lv_keyboard_set_mode(kb_job, LV_KEYBOARD_MODE_NUMBER);
+  lv_obj_set_size(kb_job, UI::CONTENT_W, UI::sy(160));
+  lv_obj_align(kb_job, LV_ALIGN_BOTTOM_MID, 0, 0);
+  lv_obj_add_event_cb(kb_job, kb_job_event, LV_EVENT_ALL, nullptr);
+  lv_keyboard_set_textarea(kb_job, ta_job_ziel);
+
+  lv_obj_add_event_cb(ta_job_ziel, [](lv_event_t*){
+    lv_keyboard_set_mode(kb_job, LV_KEYBOARD_MODE_NUMBER);
+    lv_keyboard_set_textarea(kb_job, ta_job_ziel);
+  }, LV_EVENT_FOCUSED, nullptr);
+  lv_obj_add_event_cb(ta_job_delay, [](lv_event_t*){
+    lv_keyboard_set_mode(kb_job, LV_KEYBOARD_MODE_NUMBER);
+    lv_keyboard_set_textarea(kb_job, ta_job_delay);
+  }, LV_EVENT_FOCUSED, nullptr);
+  lv_obj_add_event_cb(ta_job_label, [](lv_event_t*){
+    lv_keyboard_set_mode(kb_job, LV_KEYBOARD_MODE_TEXT_UPPER);
+    lv_keyboard_set_textarea(kb_job, ta_job_label);
+  }, LV_EVENT_FOCUSED, nullptr);
+}
+
+static void build_diag()
+{
+  scr_diag = lv_obj_create(nullptr);
+  style_screen(scr_diag);
+
+  make_header(scr_diag, "Diagnose", LAT_ENABLE ? "Latenz: Impuls -> Anzeige / Motor AUS" : "Modbus");
+
+  lv_obj_t* card = lv_obj_create(scr_diag);
+  lv_obj_set_size(card, UI::CONTENT_W, UI::sy(280));
+  lv_obj_align(card, LV_ALIGN_TOP_MID, 0, UI::CARD_Y);
+  lv_obj_set_style_radius(card, 18, 0);
+  lv_obj_set_style_border_width(card, 2, 0);
+  lv_obj_set_style_border_color(card, C_ORANGE, 0);
+  lv_obj_set_style_pad_all(card, UI::sx(16), 0);
+
+  lbl_diag = lv_label_create(card);
+  lv_obj_set_width(lbl_diag, lv_pct(100));
+  lv_label_set_long_mode(lbl_diag, LV_LABEL_LONG_WRAP);
+  lv_obj_set_style_text_font(lbl_diag, F16, 0);
+  lv_label_set_text(lbl_diag, "");
+
+  lv_obj_t* breset = make_btn_outline(scr_diag, "RESET", UI::BTN_W, UI::BTN_H);
+  lv_obj_align(breset, LV_ALIGN_BOTTOM_LEFT, UI::MARGIN, -UI::MARGIN);
+  if (!LAT_ENABLE) lv_obj_add_flag(breset, LV_OBJ_FLAG_HIDDEN);   // only latency figures reset
+  lv_obj_add_event_cb(breset, [](lv_event_t*){
+    lat_reset();
+    update_diag_ui();
+  }, LV_EVENT_CLICKED, nullptr);
+
+  lv_obj_t* bback = make_btn_fill(scr_diag, "ZURUECK", UI::BTN_W, UI::BTN_H, C_ORANGE, C_WHITE);
+  lv_obj_align(bback, LV_ALIGN_BOTTOM_RIGHT, -UI::MARGIN, -UI::MARGIN);
+  lv_obj_add_event_cb(bback, [](lv_event_t*){
     go(scr_main, LV_SCR_LOAD_ANIM_MOVE_RIGHT);
     update_main_ui();
   }, LV_EVENT_CLICKED, nullptr);
@@ -593,26 +1736,33 @@ static void build_error()
 /* ===================== Setup / Loop ===================== */
 void setup()
 {
-  Serial.begin(115200);
+  Serial.begin(SERIAL_BAUD);
   delay(150);
 
-  // Motor OFF first (failsafe)
-  pinMode((int)PIN_MOTOR_OUT, OUTPUT);
-  motorWrite(false);
+  for (uint8_t i = 0; i < LANES; i++) {
+    // Motor OFF first (failsafe)
+    pinMode((int)LANE_PIN_OUT[i], OUTPUT);
+    motorWrite(i, false);
 
-  // Sensor input
-  if (SENSOR_ACTIVE_LOW) pinMode((int)PIN_SENSOR_IN, INPUT_PULLUP);
-  else                   pinMode((int)PIN_SENSOR_IN, INPUT_PULLDOWN);
+    // Sensor input
+    if (SENSOR_ACTIVE_LOW) pinMode((int)LANE_PIN_IN[i], INPUT_PULLUP);
+    else                   pinMode((int)LANE_PIN_IN[i], INPUT_PULLDOWN);
+  }
 
   prefs.begin(NVS_NS, false);
   loadSettings();
+  loadJobs();
 
   gfx.begin();
   gfx.setBrightness(180);
+  Serial.printf("BANDWARE BOARD %s (%ux%u, %s)\n", Board::NAME, (unsigned)SCREEN_W, (unsigned)SCREEN_H, PANEL_TIMING.name);
+  if ((PANEL_RESYNC || PANEL_TEST) && !panel_scan_begin(PANEL_RESYNC)) {
+    Serial.println("BANDWARE PANEL SCAN HOOK FAILED");
+  }
 
   lv_init();
 
-  lv_disp_draw_buf_init(&draw_buf, buf1, buf2, SCREEN_W * 12);
+  lv_disp_draw_buf_init(&draw_buf, buf1, buf2, DRAW_BUF_PX);
 
   static lv_disp_drv_t disp_drv;
   lv_disp_drv_init(&disp_drv);
@@ -634,44 +1784,126 @@ void setup()
   C_GRAY   = lv_color_make(40, 40, 40);
   C_RED    = lv_palette_main(LV_PALETTE_RED);
 
+  if (PANEL_TEST) {
+    panel_test_run(PANEL_TIMING.name, PANEL_TIMING.refresh_hz(SCREEN_W, SCREEN_H), PANEL_TEST_PHASE_MS);
+  }
+
   build_main();
   build_settings();
   build_done();
   build_error();
+  build_jobs();
+  lat_reset();
+  if (DIAG_ENABLE) build_diag();
 
   lv_scr_load(scr_main);
 
   // init state
-  st = State::IDLE;
-  noInterrupts(); isr_count = 0; interrupts();
-  ist = 0;
+  for (uint8_t i = 0; i < LANES; i++) {
+    lane.st[i] = State::IDLE;
+    resetCount(i);
+  }
   update_main_ui();
 
   // fill settings fields initially
   char tmp[16];
-  snprintf(tmp, sizeof(tmp), "%lu", (unsigned long)ziel);
+  fmtQty(tmp, sizeof(tmp), sel, lane.ziel[sel], false);
   lv_textarea_set_text(ta_ziel, tmp);
-  snprintf(tmp, sizeof(tmp), "%u", (unsigned)deb_ms);
+  snprintf(tmp, sizeof(tmp), "%u", (unsigned)lane.deb_ms[sel]);
   lv_textarea_set_text(ta_deb, tmp);
 
-  // ISR attach
-  attachInterrupt((int)PIN_SENSOR_IN, sensor_isr, SENSOR_ACTIVE_LOW ? FALLING : RISING);
+  // ISR attach (the encoder lane is routed by apply_count_mode)
+  for (uint8_t i = 0; i < LANES; i++) {
+    if (i != ENC_LANE) {
+      attachInterruptArg((int)LANE_PIN_IN[i], sensor_isr, (void*)(uintptr_t)i, SENSOR_ACTIVE_LOW ? FALLING : RISING);
+    }
+    Serial.printf("BANDWARE LANE %u (Sensor=IO%d, Motor=IO%d)\n",
+                  (unsigned)(i + 1), (int)LANE_PIN_IN[i], (int)LANE_PIN_OUT[i]);
+  }
+  apply_count_mode();
+  if (len_mode) {
+    Serial.printf("BANDWARE LENGTH MODE (A=IO%d, B=IO%d, %lu/m)\n",
+                  (int)ENC_PIN_A, (int)ENC_PIN_B, (unsigned long)enc_ppm);
+  }
+
+  if (MB_ENABLE) {
+    mb_cmdq = xQueueCreate(16, sizeof(MbCmd));
+    mb_publish();
+
+    const MbConfig mc{ MB_UART, MB_PIN_TX, MB_PIN_RX, MB_PIN_DE, MB_BAUD, MB_SLAVE_ID, 0 };
+    const MbModel  mm{ mb_read_regs, mb_write_regs, mb_read_coils, mb_write_coils };
+    if (mb_begin(mc, mm)) Serial.printf("BANDWARE MODBUS (ID=%u, %lu 8E1)\n", (unsigned)MB_SLAVE_ID, (unsigned long)MB_BAUD);
+    else                  Serial.println("BANDWARE MODBUS FAILED");
+  }
 
-  Serial.println("BANDWARE READY (Sensor=IO17, Motor=IO12)");
+  Serial.println("BANDWARE READY");
+
+  // from here on the serial port carries binary frames
+  if (TEL_ENABLE) tel_begin(Serial, 0);
+  if (MIRROR_ENABLE) {
+    mirror_begin([](int32_t x, int32_t y, int32_t w, uint16_t* px){
+      gfx.waitDMA();
+      gfx.readRect(x, y, w, 1, (lgfx::rgb565_t*)px);
+    }, Serial, SCREEN_W, SCREEN_H, 0);
+  }
 }
 
 void loop()
 {
+  const uint32_t t0 = micros();
   lv_timer_handler();
+  const uint32_t t_ui = micros() - t0;
   delay(5);
+  const uint32_t t1 = micros();
+
+  mb_apply();
+
+  if (MIRROR_ENABLE) {
+    mirror_rx(Serial);
+    mirror_service(MIRROR_BUDGET_US);
+  }
 
   // failsafe
-  if (st == State::ERROR && motor_on) motorWrite(false);
+  for (uint8_t i = 0; i < LANES; i++) {
+    if (lane.st[i] == State::ERROR && lane.motor_on[i]) motorWrite(i, false);
+  }
 
   static uint32_t last = 0;
   uint32_t now = millis();
   if (now - last >= 80) {
     last = now;
-    if (st != State::ERROR) process_workflow();
+    process_workflow();
+    if (MB_ENABLE) mb_publish();
+
+    // flash writes stall the loop and non-IRAM ISRs: never while a belt runs
+    if (jobs_dirty && !any_lane_running()) saveJobs();
+
+    if (DIAG_ENABLE) {
+      static uint32_t last_diag = 0;
+      if (lv_scr_act() == scr_diag && now - last_diag >= 500) {
+        last_diag = now;
+        update_diag_ui();
+      }
+    }
+    if (LAT_ENABLE) {
+      static uint32_t last_rep = 0;
+      if (!TEL_ENABLE && !MIRROR_ENABLE && now - last_rep >= LAT_REPORT_MS) {
+        last_rep = now;
+        lat_print();
+      }
+    }
+  }
+
+  if (TEL_ENABLE) {
+    const uint32_t work = t_ui + (micros() - t1);
+    loop_sum_us += work;
+    if (work > loop_max_us) loop_max_us = work;
+    loop_n++;
+
+    static uint32_t last_tel = 0;
+    if (now - last_tel >= TEL_PERIOD_MS) {
+      last_tel = now;
+      tel_emit(now);
+    }
   }
 }
@@ -0,0 +1,310 @@
+#include "mirror.h"
+
+#include <atomic>
+
+static constexpr uint8_t  SYNC0 = 0xA5;
+static constexpr uint8_t  SYNC_TX = 0x5B;
+static constexpr uint8_t  SYNC_RX = 0x5C;
+static constexpr uint8_t  T_ROW = 0x01, T_HELLO = 0x02, T_TOUCH = 0x10, T_REFRESH = 0x11;
+
+static constexpr uint16_t MAX_W = 800;
+static constexpr uint8_t  MAX_DIRTY = 8;
+static constexpr uint32_t RING = 16384;   // bytes, power of two
+static constexpr uint32_t TOUCH_HOLD_MS = 500;   // release if the viewer goes quiet
+static_assert((RING & (RING - 1)) == 0, "ring size must be a power of two");
+
+/* worst case row: all literals, one op byte per 64 pixels */
+static constexpr uint32_t ROW_MAX = 5 + 6 + MAX_W * 2 + (MAX_W + 63) / 64 + 2;
+
+struct Rect { int16_t x1, y1, x2, y2; };
+
+static MirrorReadRow read_row = nullptr;
+static Print* out = nullptr;
+static uint16_t scr_w = 0, scr_h = 0;
+
+/* dirty list, touched by flush + service (both loop()) */
+static Rect dirty[MAX_DIRTY];
+static uint8_t n_dirty = 0;
+static Rect cur;
+static int16_t cur_y = 0;
+static bool busy = false;
+static bool hello_pending = false;   // sent by mirror_service() once the ring has room
+
+/* what the viewer currently shows; only trusted after a full-screen pass */
+static uint16_t* shadow = nullptr;
+static bool shadow_valid = false;
+
+static uint16_t row[MAX_W];
+static uint8_t  frame[ROW_MAX];
+
+/* frame ring: loop() produces whole frames, the task consumes them */
+static uint8_t ring[RING];
+static std::atomic<uint32_t> head{0};
+static std::atomic<uint32_t> tail{0};
+static TaskHandle_t task = nullptr;
+
+/* remote touch */
+static bool     t_down = false;
+static uint16_t t_x = 0, t_y = 0;
+static uint32_t t_ms = 0;
+
+static uint16_t crc16_ccitt(const uint8_t* p, size_t n)
+{
+  uint16_t crc = 0xFFFF;
+  while (n--) {
+    crc ^= (uint16_t)(*p++) << 8;
+    for (int i = 0; i < 8; i++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+  }
+  return crc;
+}
+
+static inline void put16(uint8_t* p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+static inline uint16_t get16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+/* ===================== Ring ===================== */
+static uint32_t ring_free()
+{
+  return RING - (head.load(std::memory_order_relaxed) - tail.load(std::memory_order_acquire));
+}
+
+/* Queues frame[0..n) (sync/type/len + CRC already in place). Frame bounds in
+   the ring come from the headers, so a frame that does not fit is dropped
+   whole rather than overwriting what the task has not sent yet. */
+static bool ring_put(uint32_t n)
+{
+  if (ring_free() < n) return false;
+  uint32_t h = head.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < n; i++) ring[(h + i) & (RING - 1)] = frame[i];
+  head.store(h + n, std::memory_order_release);
+  if (task) xTaskNotifyGive(task);
+  return true;
+}
+
+static uint32_t finish_frame(uint8_t type, uint32_t payload)
+{
+  frame[0] = SYNC0;
+  frame[1] = SYNC_TX;
+  frame[2] = type;
+  put16(&frame[3], (uint16_t)payload);
+  const uint16_t crc = crc16_ccitt(&frame[2], 3 + payload);
+  put16(&frame[5 + payload], crc);
+  return 5 + payload + 2;
+}
+
+static void mirror_task(void*)
+{
+  static uint8_t buf[ROW_MAX];
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    while (t != head.load(std::memory_order_acquire)) {
+      // frames are queued whole, so the header is always there
+      const uint32_t n = 5 + (ring[(t + 3) & (RING - 1)] | (ring[(t + 4) & (RING - 1)] << 8)) + 2;
+      for (uint32_t i = 0; i < n; i++) buf[i] = ring[(t + i) & (RING - 1)];
+      t += n;
+      tail.store(t, std::memory_order_release);
+      out->write(buf, n);   // one write per frame keeps other serial users from splitting it
+    }
+  }
+}
+
+/* ===================== Dirty rectangles ===================== */
+static bool touches(const Rect& a, const Rect& b)
+{
+  return a.x1 <= b.x2 + 1 && b.x1 <= a.x2 + 1 && a.y1 <= b.y2 + 1 && b.y1 <= a.y2 + 1;
+}
+
+static void unite(Rect& a, const Rect& b)
+{
+  if (b.x1 < a.x1) a.x1 = b.x1;
+  if (b.y1 < a.y1) a.y1 = b.y1;
+  if (b.x2 > a.x2) a.x2 = b.x2;
+  if (b.y2 > a.y2) a.y2 = b.y2;
+}
+
+void mirror_mark(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+  if (!out) return;
+  Rect r{ (int16_t)x1, (int16_t)y1, (int16_t)x2, (int16_t)y2 };
+
+  for (uint8_t i = 0; i < n_dirty; i++) {
+    if (touches(dirty[i], r)) {
+      unite(dirty[i], r);
+      return;
+    }
+  }
+  if (n_dirty < MAX_DIRTY) {
+    dirty[n_dirty++] = r;
+    return;
+  }
+  // list full: fold everything into one box
+  for (uint8_t i = 1; i < n_dirty; i++) unite(dirty[0], dirty[i]);
+  unite(dirty[0], r);
+  n_dirty = 1;
+}
+
+static void send_hello()
+{
+  put16(&frame[5], scr_w);
+  put16(&frame[7], scr_h);
+  ring_put(finish_frame(T_HELLO, 4));
+}
+
+static void refresh_all()
+{
+  shadow_valid = false;
+  busy = false;
+  n_dirty = 0;
+  mirror_mark(0, 0, scr_w - 1, scr_h - 1);
+}
+
+/* ===================== Row encoder ===================== */
+static uint32_t encode_row(int16_t x, int16_t y, int16_t w)
+{
+  read_row(x, y, w, row);
+
+  uint16_t* sh = shadow ? &shadow[(uint32_t)y * scr_w + x] : nullptr;
+  const bool delta = sh && shadow_valid;
+
+  uint8_t* p = &frame[5 + 6];
+  int32_t i = 0;
+  int32_t pending_skip = 0;   // trailing skips are never emitted
+
+  while (i < w) {
+    if (delta && row[i] == sh[i]) {
+      pending_skip++;
+      i++;
+      continue;
+    }
+    while (pending_skip > 0) {
+      const int32_t c = pending_skip > 64 ? 64 : pending_skip;
+      *p++ = (uint8_t)(0x00 | (c - 1));
+      pending_skip -= c;
+    }
+
+    int32_t run = 1;
+    while (i + run < w && run < 64 && row[i + run] == row[i]) run++;
+    if (run >= 3) {
+      *p++ = (uint8_t)(0x40 | (run - 1));
+      put16(p, row[i]);
+      p += 2;
+      i += run;
+      continue;
+    }
+
+    // literal until a run of 3 or an unchanged pixel starts
+    int32_t n = 0;
+    uint8_t* op = p++;
+    while (i < w && n < 64) {
+      if (delta && row[i] == sh[i]) break;
+      if (i + 2 < w && row[i] == row[i + 1] && row[i] == row[i + 2]) break;
+      put16(p, row[i]);
+      p += 2;
+      i++;
+      n++;
+    }
+    *op = (uint8_t)(0x80 | (n - 1));
+  }
+
+  const uint32_t payload = (uint32_t)(p - &frame[5]);
+  if (sh) memcpy(sh, row, w * sizeof(uint16_t));
+  if (payload == 6) return 0;   // nothing changed in this row
+
+  put16(&frame[5], x);
+  put16(&frame[7], y);
+  put16(&frame[9], w);
+  return finish_frame(T_ROW, payload);
+}
+
+void mirror_service(uint32_t budget_us)
+{
+  if (!out) return;
+  const uint32_t t0 = micros();
+
+  if (hello_pending) {
+    if (ring_free() < ROW_MAX) return;
+    send_hello();
+    hello_pending = false;
+  }
+
+  while (micros() - t0 < budget_us) {
+    if (!busy) {
+      if (n_dirty == 0) return;
+      cur = dirty[--n_dirty];
+      cur_y = cur.y1;
+      busy = true;
+    }
+    if (ring_free() < ROW_MAX) return;   // link is behind; pick up here next time
+
+    const uint32_t n = encode_row(cur.x1, cur_y, cur.x2 - cur.x1 + 1);
+    if (n) ring_put(n);
+
+    if (++cur_y > cur.y2) {
+      busy = false;
+      if (cur.x1 == 0 && cur.y1 == 0 && cur.x2 == scr_w - 1 && cur.y2 == scr_h - 1) shadow_valid = true;
+    }
+  }
+}
+
+/* ===================== Host -> device ===================== */
+void mirror_rx(Stream& in)
+{
+  static uint8_t b[16];
+  static uint8_t n = 0;
+
+  while (in.available() > 0) {
+    const uint8_t c = (uint8_t)in.read();
+    if (n == 0 && c != SYNC0) continue;
+    if (n == 1 && c != SYNC_RX) { n = (c == SYNC0) ? 1 : 0; continue; }
+    b[n++] = c;
+
+    if (n < 5) continue;
+    const uint16_t len = get16(&b[3]);
+    if (len > sizeof(b) - 7) { n = 0; continue; }
+    if (n < 5 + len + 2) continue;
+    n = 0;
+
+    if (crc16_ccitt(&b[2], 3 + len) != get16(&b[5 + len])) continue;
+
+    if (b[2] == T_TOUCH && len == 5) {
+      t_x = get16(&b[5]);
+      t_y = get16(&b[7]);
+      t_down = b[9] != 0;
+      t_ms = millis();
+    } else if (b[2] == T_REFRESH) {
+      hello_pending = true;
+      refresh_all();
+    }
+  }
+}
+
+bool mirror_touch(uint16_t* x, uint16_t* y)
+{
+  if (!t_down) return false;
+  if (millis() - t_ms > TOUCH_HOLD_MS) {
+    t_down = false;
+    return false;
+  }
+  *x = t_x;
+  *y = t_y;
+  return true;
+}
+
+/* ===================== Setup ===================== */
+bool mirror_begin(MirrorReadRow rd, Print& o, uint16_t w, uint16_t h, BaseType_t core)
+{
+  if (w > MAX_W) return false;
+  read_row = rd;
+  scr_w = w;
+  scr_h = h;
+
+  // without PSRAM the mirror still works, just without the delta step
+  shadow = (uint16_t*)ps_malloc((size_t)w * h * sizeof(uint16_t));
+
+  if (xTaskCreatePinnedToCore(mirror_task, "mirror", 2048, nullptr, 1, &task, core) != pdPASS) return false;
+  out = &o;
+  hello_pending = true;
+  refresh_all();
+  return true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Arduino.h>
+
+/* ===================== Remote screen mirroring =====================
+   my_disp_flush() only records dirty rectangles (mirror_mark). loop() calls
+   mirror_service() with a time budget: it reads rows back from the panel,
+   delta-encodes them against a shadow copy of what the viewer already has,
+   and queues finished frames in a byte ring. A low-priority task drains the
+   ring to the serial port, so a slow link only delays the mirror, never
+   the panel. tools/mirror_view.py shows the screen and sends touches back.
+
+   Device -> host:  0xA5 0x5B | type | len (LE16) | payload | CRC-16/CCITT (LE)
+     type 0x01 ROW    x, y, w (LE16 each) + ops
+     type 0x02 HELLO  width, height (LE16)
+   Row ops, count = (op & 0x3F) + 1:
+     0b00 SKIP count   pixels unchanged since the last frame
+     0b01 RUN  count   followed by one RGB565 pixel (LE)
+     0b10 LIT  count   followed by count RGB565 pixels (LE)
+   Host -> device:  0xA5 0x5C | type | len | payload | CRC, same layout
+     type 0x10 TOUCH   x, y (LE16), pressed (u8)
+     type 0x11 REFRESH resend the whole screen
+   CRC covers type + len + payload. */
+
+typedef void (*MirrorReadRow)(int32_t x, int32_t y, int32_t w, uint16_t* px);
+
+bool mirror_begin(MirrorReadRow read_row, Print& out, uint16_t w, uint16_t h, BaseType_t core);
+void mirror_mark(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+void mirror_service(uint32_t budget_us);
+void mirror_rx(Stream& in);
+bool mirror_touch(uint16_t* x, uint16_t* y);
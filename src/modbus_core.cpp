@@ -0,0 +1,208 @@
+#include "modbus_core.h"
+
+#include <string.h>
+
+static constexpr uint16_t LEN_UNKNOWN = 0xFFFF;
+
+/* ===================== Helpers ===================== */
+static inline uint16_t crc16_step(uint16_t crc, uint8_t b)
+{
+  crc ^= b;
+  for (int i = 0; i < 8; i++) crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : (crc >> 1);
+  return crc;
+}
+
+static inline uint16_t be16(const uint8_t* p) { return (uint16_t)((p[0] << 8) | p[1]); }
+static inline void put_be16(uint8_t* p, uint16_t v) { p[0] = v >> 8; p[1] = v & 0xFF; }
+
+static void rx_reset(MbCore& c)
+{
+  c.rx_len  = 0;
+  c.rx_need = 0;
+  c.rx_crc  = 0xFFFF;
+}
+
+/* Request length from the header bytes received so far; 0 = need more */
+static uint16_t request_len(const MbCore& c)
+{
+  if (c.rx_len < 2) return 0;
+  switch (c.rx[1]) {
+    case 0x01: case 0x03: case 0x04: case 0x05: case 0x06:
+      return 8;
+    case 0x0F: case 0x10:
+      if (c.rx_len < 7) return 0;
+      return 9 + c.rx[6];
+  }
+  return LEN_UNKNOWN;
+}
+
+/* ===================== Request handling ===================== */
+static uint16_t exception(MbCore& c, uint8_t ex)
+{
+  c.tx[1] |= 0x80;
+  c.tx[2] = ex;
+  return 3;
+}
+
+/* Builds the reply for the complete frame in rx[]; returns its length without CRC */
+static uint16_t handle_request(MbCore& c)
+{
+  const uint8_t* rx = c.rx;
+  uint8_t* tx = c.tx;
+  const uint8_t  fc   = rx[1];
+  const uint16_t addr = be16(&rx[2]);
+  const uint16_t qty  = be16(&rx[4]);
+  uint8_t ex = MB_EX_NONE;
+
+  tx[0] = rx[0];
+  tx[1] = fc;
+
+  switch (fc) {
+    case 0x01: {
+      if (qty < 1 || qty > 2000) return exception(c, MB_EX_ILLEGAL_VALUE);
+      const uint8_t bytes = (uint8_t)((qty + 7) / 8);
+      memset(&tx[3], 0, bytes);
+      ex = c.model.read_coils(addr, qty, &tx[3]);
+      if (ex) return exception(c, ex);
+      tx[2] = bytes;
+      return 3 + bytes;
+    }
+
+    case 0x03:
+    case 0x04: {
+      if (qty < 1 || qty > 125) return exception(c, MB_EX_ILLEGAL_VALUE);
+      uint16_t regs[125];
+      ex = c.model.read_regs(addr, qty, regs);
+      if (ex) return exception(c, ex);
+      tx[2] = (uint8_t)(qty * 2);
+      for (uint16_t i = 0; i < qty; i++) put_be16(&tx[3 + i * 2], regs[i]);
+      return 3 + qty * 2;
+    }
+
+    case 0x05: {
+      if (qty != 0xFF00 && qty != 0x0000) return exception(c, MB_EX_ILLEGAL_VALUE);
+      const uint8_t bit = qty ? 1 : 0;
+      ex = c.model.write_coils(addr, 1, &bit);
+      if (ex) return exception(c, ex);
+      memcpy(&tx[2], &rx[2], 4);   // echo
+      return 6;
+    }
+
+    case 0x06:
+      ex = c.model.write_regs(addr, 1, &rx[4]);
+      if (ex) return exception(c, ex);
+      memcpy(&tx[2], &rx[2], 4);   // echo
+      return 6;
+
+    case 0x0F:
+      if (qty < 1 || qty > 1968 || rx[6] != (qty + 7) / 8) return exception(c, MB_EX_ILLEGAL_VALUE);
+      ex = c.model.write_coils(addr, qty, &rx[7]);
+      if (ex) return exception(c, ex);
+      memcpy(&tx[2], &rx[2], 4);
+      return 6;
+
+    case 0x10:
+      if (qty < 1 || qty > 123 || rx[6] != qty * 2) return exception(c, MB_EX_ILLEGAL_VALUE);
+      ex = c.model.write_regs(addr, qty, &rx[7]);
+      if (ex) return exception(c, ex);
+      memcpy(&tx[2], &rx[2], 4);
+      return 6;
+  }
+  return exception(c, MB_EX_ILLEGAL_FUNC);
+}
+
+/* Complete frame in rx[]: returns the reply length with CRC, 0 = no reply */
+static uint16_t frame_done(MbCore& c)
+{
+  if (c.rx_crc != 0) {
+    c.errors++;
+    return 0;
+  }
+  c.frames++;
+
+  uint16_t n = handle_request(c);
+  if (c.rx[0] == 0) return 0;   // broadcast: act, never answer
+
+  uint16_t crc = 0xFFFF;
+  for (uint16_t i = 0; i < n; i++) crc = crc16_step(crc, c.tx[i]);
+  c.tx[n++] = crc & 0xFF;
+  c.tx[n++] = crc >> 8;
+  return n;
+}
+
+/* ===================== API ===================== */
+void mb_core_init(MbCore& c, uint8_t slave_id, const MbModel& model)
+{
+  memset(&c, 0, sizeof(c));
+  c.slave_id = slave_id;
+  c.model = model;
+  rx_reset(c);
+}
+
+void mb_core_gap(MbCore& c)
+{
+  if (c.rx_len) c.errors++;   // previous frame never completed
+  rx_reset(c);
+  c.rx_skip = false;
+}
+
+void mb_core_drop(MbCore& c)
+{
+  c.errors++;
+  rx_reset(c);
+  c.rx_skip = true;
+}
+
+uint16_t mb_core_want(const MbCore& c)
+{
+  if (c.rx_skip)     return 0;
+  if (c.rx_need)     return c.rx_need - c.rx_len;
+  if (c.rx_len < 2)  return 2 - c.rx_len;   // address + function code
+  return 7 - c.rx_len;                      // up to the FC15/FC16 byte count
+}
+
+void mb_core_commit(MbCore& c, uint16_t n, uint16_t* reply_len)
+{
+  *reply_len = 0;
+  if (n == 0 || c.rx_skip) return;
+
+  const uint16_t start = c.rx_len;
+  for (uint16_t i = start; i < start + n; i++) c.rx_crc = crc16_step(c.rx_crc, c.rx[i]);
+  c.rx_len += n;
+
+  // not for us (or another slave's reply): ignore the rest of it
+  if (start == 0 && c.rx[0] != c.slave_id && c.rx[0] != 0) {
+    rx_reset(c);
+    c.rx_skip = true;
+    return;
+  }
+
+  if (!c.rx_need) {
+    const uint16_t need = request_len(c);
+    if (need == LEN_UNKNOWN || need > MB_FRAME_MAX) {
+      mb_core_drop(c);
+      return;
+    }
+    c.rx_need = need;
+  }
+
+  if (c.rx_need && c.rx_len == c.rx_need) {
+    *reply_len = frame_done(c);
+    rx_reset(c);
+  }
+}
+
+uint16_t mb_core_feed(MbCore& c, const uint8_t* p, uint16_t n, uint16_t* reply_len)
+{
+  *reply_len = 0;
+  uint16_t used = 0;
+  while (used < n && !c.rx_skip) {
+    uint16_t k = mb_core_want(c);
+    if (k > n - used) k = n - used;
+    memcpy(mb_core_wptr(c), &p[used], k);
+    used += k;
+    mb_core_commit(c, k, reply_len);
+    if (*reply_len) return used;
+  }
+  return n;
+}
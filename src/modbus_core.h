@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stdint.h>
+
+/* ===================== Modbus RTU frame core =====================
+   Everything between the serial line and the data model: framing by
+   request length, CRC, slave addressing, request decoding and the reply.
+   No hardware access, so the slave task (modbus_rtu.cpp) and the host
+   test (test/test_modbus) run the same code. */
+
+/* Exception codes returned by the model callbacks (0 = OK) */
+static constexpr uint8_t MB_EX_NONE          = 0;
+static constexpr uint8_t MB_EX_ILLEGAL_FUNC  = 1;
+static constexpr uint8_t MB_EX_ILLEGAL_ADDR  = 2;
+static constexpr uint8_t MB_EX_ILLEGAL_VALUE = 3;
+static constexpr uint8_t MB_EX_BUSY          = 6;
+
+struct MbModel {
+  // FC03 / FC04; out[] is host order
+  uint8_t (*read_regs)(uint16_t addr, uint16_t n, uint16_t* out);
+  // FC06 / FC16; words[] points into the request frame (big endian)
+  uint8_t (*write_regs)(uint16_t addr, uint16_t n, const uint8_t* words);
+  // FC01; bits[] is LSB-first as on the wire
+  uint8_t (*read_coils)(uint16_t addr, uint16_t n, uint8_t* bits);
+  // FC05 / FC15; bits[] points into the request frame
+  uint8_t (*write_coils)(uint16_t addr, uint16_t n, const uint8_t* bits);
+};
+
+static constexpr uint16_t MB_FRAME_MAX = 256;
+
+struct MbCore {
+  uint8_t  slave_id;
+  MbModel  model;
+
+  uint8_t  rx[MB_FRAME_MAX];
+  uint16_t rx_len;
+  uint16_t rx_need;     // full frame length once known, else 0
+  uint16_t rx_crc;      // running CRC; 0 over data + CRC means valid
+  bool     rx_skip;     // drop bytes until the next 3.5 char gap
+
+  uint8_t  tx[MB_FRAME_MAX];
+
+  uint32_t frames;      // complete frames with a good CRC
+  uint32_t errors;      // CRC, framing, line errors
+};
+
+void mb_core_init(MbCore& c, uint8_t slave_id, const MbModel& model);
+
+/* 3.5 character silence seen: an unfinished frame is dropped */
+void mb_core_gap(MbCore& c);
+
+/* Parity/framing error or lost bytes: ignore the line up to the next gap */
+void mb_core_drop(MbCore& c);
+
+/* Zero-copy receive: the driver reads up to mb_core_want() bytes straight
+   to mb_core_wptr() and reports them with mb_core_commit(). want never
+   reaches past the end of the current frame; it is 0 while skipping.
+   *reply_len is the length of the reply in c.tx (CRC included), 0 if
+   nothing is to be sent. */
+uint16_t mb_core_want(const MbCore& c);
+inline uint8_t* mb_core_wptr(MbCore& c) { return &c.rx[c.rx_len]; }
+void mb_core_commit(MbCore& c, uint16_t n, uint16_t* reply_len);
+
+/* Same for bytes that are already in a buffer (host test): consumes up to
+   the end of a frame that has a reply and returns how many it took. */
+uint16_t mb_core_feed(MbCore& c, const uint8_t* p, uint16_t n, uint16_t* reply_len);
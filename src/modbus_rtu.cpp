@@ -0,0 +1,103 @@
+#include "modbus_rtu.h"
+
+/* ===================== State ===================== */
+static MbConfig cfg;
+static MbCore   core;
+static QueueHandle_t evq = nullptr;
+
+static volatile uint32_t st_tx = 0;
+
+/* ===================== UART side ===================== */
+/* Takes exactly the len bytes of one UART_DATA event, read from the driver
+   straight into the core's frame buffer, never past the end of a frame.
+   idle = the event came from the RX timeout: the line went quiet after
+   these bytes, which is the frame gap. Timing comes from the UART itself,
+   not from when this task got to run. */
+static void on_data(size_t len, bool idle)
+{
+  while (len > 0) {
+    if (core.rx_skip) {
+      uint8_t sink[32];
+      const int r = uart_read_bytes(cfg.port, sink, len > sizeof(sink) ? sizeof(sink) : len, 0);
+      if (r <= 0) break;
+      len -= r;
+      continue;
+    }
+
+    uint16_t want = mb_core_want(core);
+    if (want > len) want = (uint16_t)len;
+    const int r = uart_read_bytes(cfg.port, mb_core_wptr(core), want, 0);
+    if (r <= 0) break;
+    len -= r;
+
+    uint16_t n = 0;
+    mb_core_commit(core, (uint16_t)r, &n);
+    if (n) {
+      // lands in the driver's TX ring; the task never waits for the wire
+      uart_write_bytes(cfg.port, (const char*)core.tx, n);
+      st_tx++;
+    }
+  }
+
+  if (idle) mb_core_gap(core);
+}
+
+static void mb_task(void*)
+{
+  uart_event_t ev;
+  for (;;) {
+    if (xQueueReceive(evq, &ev, portMAX_DELAY) != pdTRUE) continue;
+
+    switch (ev.type) {
+      case UART_DATA:
+        on_data(ev.size, ev.timeout_flag);
+        break;
+
+      case UART_FIFO_OVF:
+      case UART_BUFFER_FULL:
+        uart_flush_input(cfg.port);
+        xQueueReset(evq);
+        mb_core_drop(core);
+        break;
+
+      case UART_PARITY_ERR:
+      case UART_FRAME_ERR:
+        mb_core_drop(core);
+        break;
+
+      default:
+        break;
+    }
+  }
+}
+
+/* ===================== API ===================== */
+bool mb_begin(const MbConfig& c, const MbModel& m)
+{
+  cfg = c;
+  mb_core_init(core, cfg.slave_id, m);
+
+  uart_config_t uc = {};
+  uc.baud_rate  = (int)cfg.baud;
+  uc.data_bits  = UART_DATA_8_BITS;
+  uc.parity     = UART_PARITY_EVEN;
+  uc.stop_bits  = UART_STOP_BITS_1;
+  uc.flow_ctrl  = UART_HW_FLOWCTRL_DISABLE;
+  uc.source_clk = UART_SCLK_APB;
+
+  if (uart_driver_install(cfg.port, 512, 256, 16, &evq, 0) != ESP_OK) return false;
+  if (uart_param_config(cfg.port, &uc) != ESP_OK) return false;
+  if (uart_set_pin(cfg.port, cfg.pin_tx, cfg.pin_rx, cfg.pin_de, UART_PIN_NO_CHANGE) != ESP_OK) return false;
+  if (cfg.pin_de != GPIO_NUM_NC) uart_set_mode(cfg.port, UART_MODE_RS485_HALF_DUPLEX);
+
+  // RX timeout after 3 quiet characters: UART_DATA with timeout_flag marks the
+  // end of a frame (RTU: >= 3.5 between frames, <= 1.5 inside one)
+  uart_set_rx_timeout(cfg.port, 3);
+
+  return xTaskCreatePinnedToCore(mb_task, "modbus", 3072, nullptr, 5, nullptr, cfg.core) == pdPASS;
+}
+
+MbStats mb_stats()
+{
+  return MbStats{ core.frames, st_tx, core.errors };
+}
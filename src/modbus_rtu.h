@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Arduino.h>
+#include <driver/uart.h>
+
+#include "modbus_core.h"
+
+/* ===================== Modbus RTU slave =====================
+   Runs on its own UART and FreeRTOS task. Bytes go to the frame core
+   (modbus_core.h) as the UART driver reports them; the application only
+   supplies the data model. All callbacks run in the Modbus task, never in
+   loop(), so they must not touch LVGL or the lane table directly. */
+
+struct MbConfig {
+  uart_port_t port;
+  gpio_num_t  pin_tx;
+  gpio_num_t  pin_rx;
+  gpio_num_t  pin_de;      // RS485 driver enable, GPIO_NUM_NC for auto-direction modules
+  uint32_t    baud;
+  uint8_t     slave_id;
+  BaseType_t  core;        // keep away from the core that runs loop() + sensor ISRs
+};
+
+bool mb_begin(const MbConfig& cfg, const MbModel& model);
+
+/* Frames seen / answered / dropped (CRC, framing, overflow) since boot */
+struct MbStats { uint32_t rx; uint32_t tx; uint32_t err; };
+MbStats mb_stats();
@@ -0,0 +1,252 @@
+#include "panel_test.h"
+
+#include <atomic>
+#include <lvgl.h>
+#include <esp_intr_alloc.h>
+#include <hal/gdma_ll.h>
+#include <hal/lcd_ll.h>
+#include <soc/gdma_channel.h>
+
+/* ===================== Scan-out watch ===================== */
+static int      dma_ch = -1;
+static uint32_t dma_desc = 0;       // first descriptor of the frame, as set up by Bus_RGB
+static bool     resync_on = false;
+static intr_handle_t vsync_intr = nullptr;
+
+static volatile uint32_t st_frames = 0, st_underruns = 0, st_clean = 0;
+
+static IRAM_ATTR void restart_scanout()
+{
+  // same sequence as the IDF RGB driver: DMA and LCD FIFO back to line 0
+  gdma_ll_tx_reset_channel(&GDMA, dma_ch);
+  lcd_ll_stop(&LCD_CAM);
+  lcd_ll_fifo_reset(&LCD_CAM);
+  gdma_ll_tx_set_desc_addr(&GDMA, dma_ch, dma_desc);
+  gdma_ll_tx_start(&GDMA, dma_ch);
+  esp_rom_delay_us(1);   // let the DMA prime the LCD FIFO
+  lcd_ll_start(&LCD_CAM);
+}
+
+static IRAM_ATTR void vsync_isr(void*)
+{
+  const uint32_t st = lcd_ll_get_interrupt_status(&LCD_CAM);
+  lcd_ll_clear_interrupt_status(&LCD_CAM, st);
+  if (!(st & LCD_LL_EVENT_VSYNC_END)) return;
+
+  st_frames++;
+  if (GDMA.channel[dma_ch].out.int_raw.val & GDMA_LL_EVENT_TX_FIFO_UDF) {
+    gdma_ll_tx_clear_interrupt_status(&GDMA, dma_ch, GDMA_LL_EVENT_TX_FIFO_UDF);
+    st_underruns++;
+  } else {
+    st_clean++;
+  }
+  // in the blanking after VSYNC, so the restart itself costs no frame
+  if (resync_on) restart_scanout();
+}
+
+bool panel_scan_begin(bool resync)
+{
+  if (vsync_intr) return true;
+
+  // Bus_RGB does not expose its channel; find the one routed to LCD_CAM
+  for (int i = 0; i < SOC_GDMA_PAIRS_PER_GROUP; i++) {
+    if (GDMA.channel[i].out.peri_sel.sel == SOC_GDMA_TRIG_PERIPH_LCD0) {
+      dma_ch = i;
+      break;
+    }
+  }
+  if (dma_ch < 0) return false;
+
+  dma_desc = GDMA.channel[dma_ch].out.link.addr;
+  resync_on = resync;
+  gdma_ll_tx_clear_interrupt_status(&GDMA, dma_ch, GDMA_LL_EVENT_TX_FIFO_UDF);
+
+  lcd_ll_clear_interrupt_status(&LCD_CAM, UINT32_MAX);
+  lcd_ll_enable_interrupt(&LCD_CAM, LCD_LL_EVENT_VSYNC_END, true);
+  return esp_intr_alloc(ETS_LCD_CAM_INTR_SOURCE, ESP_INTR_FLAG_IRAM, vsync_isr, nullptr, &vsync_intr) == ESP_OK;
+}
+
+PanelScanStats panel_scan_stats()
+{
+  return PanelScanStats{ st_frames, st_underruns, st_clean };
+}
+
+/* ===================== PSRAM load ===================== */
+// well beyond the data cache, so every copy really goes to PSRAM
+static constexpr size_t HAMMER_BYTES = 256 * 1024;
+
+static uint8_t* ham_buf = nullptr;
+static TaskHandle_t ham_task = nullptr;
+static std::atomic<bool> ham_on{false};
+static std::atomic<bool> ham_quit{false};
+static std::atomic<bool> ham_gone{false};
+static std::atomic<uint32_t> ham_kb{0};
+
+static void hammer_task(void*)
+{
+  for (;;) {
+    if (ham_quit.load(std::memory_order_relaxed)) {
+      // leave between copies so the buffer can be freed safely
+      ham_gone.store(true, std::memory_order_release);
+      vTaskDelete(nullptr);
+    }
+    if (!ham_on.load(std::memory_order_relaxed)) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+    memcpy(ham_buf + HAMMER_BYTES, ham_buf, HAMMER_BYTES);
+    memcpy(ham_buf, ham_buf + HAMMER_BYTES, HAMMER_BYTES);
+    ham_kb.fetch_add(4 * HAMMER_BYTES / 1024, std::memory_order_relaxed);   // read + write, both ways
+  }
+}
+
+static void hammer(bool on)
+{
+  if (on && !ham_task) {
+    ham_buf = (uint8_t*)ps_malloc(2 * HAMMER_BYTES);
+    if (!ham_buf) return;
+    ham_quit.store(false, std::memory_order_relaxed);
+    ham_gone.store(false, std::memory_order_relaxed);
+    // idle priority on core 0: takes whatever loop() and the ISRs leave
+    xTaskCreatePinnedToCore(hammer_task, "psram_load", 2048, nullptr, tskIDLE_PRIORITY, &ham_task, 0);
+  }
+  if (!ham_task) return;
+  ham_on.store(on, std::memory_order_relaxed);
+  if (on) xTaskNotifyGive(ham_task);
+}
+
+/* Ends the load task and returns its 512 KB to PSRAM */
+static void hammer_end()
+{
+  if (ham_task) {
+    ham_quit.store(true, std::memory_order_relaxed);
+    xTaskNotifyGive(ham_task);
+    while (!ham_gone.load(std::memory_order_acquire)) vTaskDelay(1);
+    ham_task = nullptr;
+  }
+  free(ham_buf);
+  ham_buf = nullptr;
+}
+
+/* ===================== Stress test ===================== */
+struct Phase {
+  const char* name;
+  bool redraw;   // invalidate + render the whole screen every frame
+  bool load;     // extra PSRAM copy traffic on core 0
+};
+
+static const Phase PHASES[] = {
+  { "Ruhe",          false, false },
+  { "LVGL Vollbild", true,  false },
+  { "LVGL + PSRAM",  true,  true  },
+};
+static constexpr uint8_t N_PHASES = sizeof(PHASES) / sizeof(PHASES[0]);
+
+static constexpr uint8_t GRID_X = 6, GRID_Y = 8;
+
+static void on_close(lv_event_t* e)
+{
+  *(bool*)lv_event_get_user_data(e) = true;
+}
+
+void panel_test_run(const char* profile, float nominal_hz, uint32_t phase_ms)
+{
+  lv_obj_t* prev = lv_scr_act();
+  lv_obj_t* scr = lv_obj_create(NULL);
+  lv_obj_clear_flag(scr, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+  lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+  const lv_coord_t w = lv_disp_get_hor_res(NULL);
+  const lv_coord_t h = lv_disp_get_ver_res(NULL);
+  lv_obj_t* cells[GRID_X * GRID_Y];
+  for (uint8_t i = 0; i < GRID_X * GRID_Y; i++) {
+    cells[i] = lv_label_create(scr);
+    lv_obj_set_style_text_color(cells[i], lv_color_white(), 0);
+    lv_obj_set_pos(cells[i], (i % GRID_X) * w / GRID_X + 8, (i / GRID_X) * h / GRID_Y + 8);
+  }
+
+  lv_obj_t* info = lv_label_create(scr);
+  lv_obj_set_style_bg_color(info, lv_color_black(), 0);
+  lv_obj_set_style_bg_opa(info, LV_OPA_COVER, 0);
+  lv_obj_set_style_text_color(info, lv_color_white(), 0);
+  lv_obj_set_style_pad_all(info, 12, 0);
+  lv_obj_align(info, LV_ALIGN_CENTER, 0, 0);
+
+  lv_scr_load(scr);
+
+  char res[N_PHASES][96];
+  char buf[N_PHASES * 96 + 128];
+  uint32_t frame = 0;
+
+  Serial.printf("PANELTEST profile=%s nominal=%.1fHz phase=%lums\n", profile, nominal_hz, (unsigned long)phase_ms);
+
+  for (uint8_t p = 0; p < N_PHASES; p++) {
+    const Phase& ph = PHASES[p];
+    lv_label_set_text_fmt(info, "Display-Test %s\n%s ...", profile, ph.name);
+    lv_refr_now(NULL);
+
+    hammer(ph.load);
+    const PanelScanStats s0 = panel_scan_stats();
+    const uint32_t kb0 = ham_kb.load(std::memory_order_relaxed);
+    const uint32_t t0 = millis();
+    uint32_t ui_frames = 0;
+
+    while (millis() - t0 < phase_ms) {
+      if (ph.redraw) {
+        frame++;
+        lv_obj_set_style_bg_color(scr, lv_color_hsv_to_rgb((frame * 7) % 360, 80, 90), 0);
+        lv_obj_set_style_bg_grad_color(scr, lv_color_hsv_to_rgb((frame * 7 + 180) % 360, 80, 40), 0);
+        for (uint8_t i = 0; i < GRID_X * GRID_Y; i++) {
+          lv_label_set_text_fmt(cells[i], "%05lu", (unsigned long)((frame * 31 + i * 977) % 100000));
+        }
+        lv_obj_invalidate(scr);
+        lv_refr_now(NULL);
+        ui_frames++;
+        vTaskDelay(1);
+      } else {
+        lv_timer_handler();
+        delay(5);
+      }
+    }
+
+    const uint32_t dt = millis() - t0;
+    hammer(false);
+    const PanelScanStats s1 = panel_scan_stats();
+    const float vsync = (s1.frames - s0.frames) * 1000.0f / dt;   // always the timing rate
+    const float hz    = (s1.clean - s0.clean) * 1000.0f / dt;     // what the panel really got
+    const float fps = ui_frames * 1000.0f / dt;
+    const float mbs = (ham_kb.load(std::memory_order_relaxed) - kb0) / 1024.0f * 1000.0f / dt;
+    const uint32_t udf = s1.underruns - s0.underruns;
+
+    snprintf(res[p], sizeof(res[p]), "%-14s %5.1f/%4.1f Hz  %3lu Unterl.  UI %4.1f fps  PSRAM %5.1f MB/s",
+             ph.name, hz, vsync, (unsigned long)udf, fps, mbs);
+    Serial.printf("PANELTEST phase=\"%s\" clean=%.1fHz vsync=%.1fHz underruns=%lu ui_fps=%.1f psram_mb_s=%.1f\n",
+                  ph.name, hz, vsync, (unsigned long)udf, fps, mbs);
+  }
+  hammer_end();
+
+  int n = snprintf(buf, sizeof(buf), "Display-Test %s (nominal %.1f Hz)\nHz = fehlerfreie Bilder / VSYNC\n\n", profile, nominal_hz);
+  for (uint8_t p = 0; p < N_PHASES && n < (int)sizeof(buf); p++) {
+    n += snprintf(buf + n, sizeof(buf) - n, "%s\n", res[p]);
+  }
+  if (n < (int)sizeof(buf)) snprintf(buf + n, sizeof(buf) - n, "\nTippen zum Fortfahren");
+
+  for (uint8_t i = 0; i < GRID_X * GRID_Y; i++) lv_obj_add_flag(cells[i], LV_OBJ_FLAG_HIDDEN);
+  lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_NONE, 0);
+  lv_obj_set_style_bg_color(scr, lv_color_black(), 0);
+  lv_label_set_text(info, buf);
+  lv_obj_align(info, LV_ALIGN_CENTER, 0, 0);
+
+  bool closed = false;
+  lv_obj_add_flag(scr, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_add_event_cb(scr, on_close, LV_EVENT_CLICKED, &closed);
+  const uint32_t t_end = millis();
+  while (!closed && millis() - t_end < 30000) {
+    lv_timer_handler();
+    delay(5);
+  }
+
+  lv_scr_load(prev);
+  lv_obj_del(scr);
+}
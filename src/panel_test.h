@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Arduino.h>
+
+/* ===================== RGB panel scan-out =====================
+   The panel is fed by a circular GDMA chain straight out of the PSRAM
+   framebuffer. When LVGL and other PSRAM users starve that DMA the LCD
+   FIFO underruns, and without a restart the picture stays shifted
+   ("drift") until reset. panel_scan_begin() hooks the LCD VSYNC
+   interrupt to count frames and underruns and, with resync set,
+   restarts the DMA from the first line every frame so an underrun
+   costs one frame at most.
+
+   panel_test_run() is the tuning harness: it renders worst-case content
+   (full-screen gradient + text, every frame) with and without extra
+   PSRAM load and reports, per phase, the rate of frames that reached the
+   panel intact next to the VSYNC rate, underruns and UI frame rate, on
+   screen and over Serial. Call it after LVGL is set up. */
+
+struct PanelScanStats {
+  uint32_t frames;      // VSYNCs since panel_scan_begin()
+  uint32_t underruns;   // frames in which the DMA FIFO ran dry
+  uint32_t clean;       // frames scanned out without an underrun
+};
+
+bool panel_scan_begin(bool resync);
+PanelScanStats panel_scan_stats();
+
+void panel_test_run(const char* profile, float nominal_hz, uint32_t phase_ms);
@@ -0,0 +1,71 @@
+#include "telemetry.h"
+
+#include <atomic>
+
+static constexpr uint32_t RING = 64;   // records, power of two
+static_assert((RING & (RING - 1)) == 0, "ring size must be a power of two");
+
+static TelRecord ring[RING];
+static std::atomic<uint32_t> head{0};   // written by the producer only
+static std::atomic<uint32_t> tail{0};   // written by the consumer only
+static std::atomic<uint16_t> dropped{0};
+
+static Print* out = nullptr;
+static TaskHandle_t task = nullptr;
+
+static uint16_t crc16_ccitt(const uint8_t* p, size_t n, uint16_t crc = 0xFFFF)
+{
+  while (n--) {
+    crc ^= (uint16_t)(*p++) << 8;
+    for (int i = 0; i < 8; i++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+  }
+  return crc;
+}
+
+static void tel_task(void*)
+{
+  uint8_t frame[3 + sizeof(TelRecord) + 2];
+  frame[0] = TEL_SYNC0;
+  frame[1] = TEL_SYNC1;
+  frame[2] = sizeof(TelRecord);
+
+  for (;;) {
+    // woken by tel_push(); the timeout only guards against a lost notify
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    while (t != head.load(std::memory_order_acquire)) {
+      memcpy(&frame[3], &ring[t & (RING - 1)], sizeof(TelRecord));
+      tail.store(++t, std::memory_order_release);
+
+      const uint16_t crc = crc16_ccitt(&frame[2], 1 + sizeof(TelRecord));
+      frame[sizeof(frame) - 2] = crc & 0xFF;
+      frame[sizeof(frame) - 1] = crc >> 8;
+      out->write(frame, sizeof(frame));   // may block, but only this task
+    }
+  }
+}
+
+bool tel_begin(Print& o, BaseType_t core)
+{
+  out = &o;
+  return xTaskCreatePinnedToCore(tel_task, "telemetry", 2048, nullptr, 1, &task, core) == pdPASS;
+}
+
+bool tel_push(const TelRecord& r)
+{
+  const uint32_t h = head.load(std::memory_order_relaxed);
+  if (h - tail.load(std::memory_order_acquire) >= RING) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  ring[h & (RING - 1)] = r;
+  head.store(h + 1, std::memory_order_release);
+  if (task) xTaskNotifyGive(task);
+  return true;
+}
+
+uint16_t tel_dropped()
+{
+  return dropped.load(std::memory_order_relaxed);
+}
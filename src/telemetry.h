@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Arduino.h>
+
+/* ===================== Binary telemetry =====================
+   Fixed-size records go into a lock-free single-producer/single-consumer
+   ring (producer: loop(), consumer: a low-priority task that owns the
+   serial writes). Pushing never blocks; a full ring drops the record and
+   counts it. tools/telemetry_view.py decodes the stream.
+
+   Frame on the wire:
+     0xA5 0x5A | len (payload bytes) | payload | CRC-16/CCITT-FALSE (LE)
+   CRC covers len + payload. Text printed to Serial in between is skipped
+   by the decoder. */
+
+static constexpr uint8_t TEL_SYNC0 = 0xA5;
+static constexpr uint8_t TEL_SYNC1 = 0x5A;
+
+struct __attribute__((packed)) TelRecord {
+  uint16_t seq;
+  uint32_t t_ms;
+  uint8_t  lane;
+  uint8_t  state;          // State enum value
+  uint8_t  motor;
+  uint8_t  flags;          // bit0: length mode (count/rate in cm)
+  uint32_t count;
+  uint32_t rate_pm;        // per minute over the last period
+  uint16_t loop_avg_us;    // loop() work time without the idle delay
+  uint16_t loop_max_us;
+  uint32_t heap_free;
+  uint16_t dropped;        // records lost to a full ring so far
+};
+static_assert(sizeof(TelRecord) == 28, "wire format, keep in sync with tools/telemetry_view.py");
+
+bool tel_begin(Print& out, BaseType_t core);
+bool tel_push(const TelRecord& r);
+uint16_t tel_dropped();
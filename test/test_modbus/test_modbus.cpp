@@ -0,0 +1,307 @@
+/* Modbus RTU slave against a pseudo-terminal: the test is the PLC on the
+   master end, the frame core serves the slave end exactly like mb_task
+   serves the UART (a quiet line stands in for the 3.5 character gap).
+   Host only:  pio test -e native */
+
+#include <unity.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "modbus_core.h"
+
+static constexpr uint8_t SLAVE = 1;
+static constexpr int QUIET_MS = 20;
+
+static int mfd = -1;   // PLC side
+static int sfd = -1;   // slave side
+static MbCore core;
+
+/* ===================== Data model ===================== */
+static constexpr uint16_t N_REGS = 16, N_COILS = 16;
+static uint16_t regs[N_REGS];
+static uint8_t  coils[N_COILS];
+
+static uint8_t read_regs(uint16_t addr, uint16_t n, uint16_t* out)
+{
+  if (addr + n > N_REGS) return MB_EX_ILLEGAL_ADDR;
+  memcpy(out, &regs[addr], n * sizeof(uint16_t));
+  return MB_EX_NONE;
+}
+
+static uint8_t write_regs(uint16_t addr, uint16_t n, const uint8_t* words)
+{
+  if (addr + n > N_REGS) return MB_EX_ILLEGAL_ADDR;
+  for (uint16_t i = 0; i < n; i++) regs[addr + i] = (uint16_t)((words[i * 2] << 8) | words[i * 2 + 1]);
+  return MB_EX_NONE;
+}
+
+static uint8_t read_coils(uint16_t addr, uint16_t n, uint8_t* bits)
+{
+  if (addr + n > N_COILS) return MB_EX_ILLEGAL_ADDR;
+  for (uint16_t i = 0; i < n; i++) if (coils[addr + i]) bits[i / 8] |= 1 << (i % 8);
+  return MB_EX_NONE;
+}
+
+static uint8_t write_coils(uint16_t addr, uint16_t n, const uint8_t* bits)
+{
+  if (addr + n > N_COILS) return MB_EX_ILLEGAL_ADDR;
+  for (uint16_t i = 0; i < n; i++) coils[addr + i] = (bits[i / 8] >> (i % 8)) & 1;
+  return MB_EX_NONE;
+}
+
+/* ===================== Line ===================== */
+/* kept separate from the core's CRC on purpose */
+static uint16_t crc16(const uint8_t* p, size_t n)
+{
+  uint16_t crc = 0xFFFF;
+  while (n--) {
+    crc ^= *p++;
+    for (int i = 0; i < 8; i++) crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : (crc >> 1);
+  }
+  return crc;
+}
+
+/* Everything that arrives on fd until it has been quiet for QUIET_MS */
+static size_t read_burst(int fd, uint8_t* buf, size_t cap)
+{
+  size_t n = 0;
+  pollfd pfd{ fd, POLLIN, 0 };
+  while (n < cap && poll(&pfd, 1, QUIET_MS) > 0) {
+    const ssize_t r = read(fd, &buf[n], cap - n);
+    if (r <= 0) break;
+    n += (size_t)r;
+  }
+  return n;
+}
+
+/* Slave end, as on_data(): reads straight into the core's frame buffer,
+   never past the end of a frame; the quiet line afterwards is the gap */
+static void serve()
+{
+  pollfd pfd{ sfd, POLLIN, 0 };
+  while (poll(&pfd, 1, QUIET_MS) > 0) {
+    const uint16_t want = mb_core_want(core);
+    uint8_t sink[32];
+    const ssize_t r = want ? read(sfd, mb_core_wptr(core), want) : read(sfd, sink, sizeof(sink));
+    if (r <= 0) break;
+    if (!want) continue;
+
+    uint16_t len = 0;
+    mb_core_commit(core, (uint16_t)r, &len);
+    if (len) TEST_ASSERT_EQUAL((ssize_t)len, write(sfd, core.tx, len));
+  }
+  mb_core_gap(core);
+}
+
+/* Sends slave + pdu (+ CRC unless raw) and returns the reply length, 0 = none */
+static size_t transact(uint8_t slave, const uint8_t* pdu, size_t n, uint8_t* reply, bool raw = false)
+{
+  uint8_t frame[300];
+  frame[0] = slave;
+  memcpy(&frame[1], pdu, n);
+  n++;
+  if (!raw) {
+    const uint16_t crc = crc16(frame, n);
+    frame[n++] = crc & 0xFF;
+    frame[n++] = crc >> 8;
+  }
+  TEST_ASSERT_EQUAL((ssize_t)n, write(mfd, frame, n));
+
+  serve();
+  const size_t r = read_burst(mfd, reply, 300);
+  if (r) TEST_ASSERT_EQUAL_HEX16_MESSAGE(0, crc16(reply, r), "reply CRC");
+  return r;
+}
+
+static void expect_exception(const uint8_t* pdu, size_t n, uint8_t ex)
+{
+  uint8_t reply[300];
+  TEST_ASSERT_EQUAL(5, transact(SLAVE, pdu, n, reply));
+  TEST_ASSERT_EQUAL_HEX8(pdu[0] | 0x80, reply[1]);
+  TEST_ASSERT_EQUAL(ex, reply[2]);
+}
+
+/* ===================== Fixtures ===================== */
+void setUp()
+{
+  mfd = posix_openpt(O_RDWR | O_NOCTTY);
+  TEST_ASSERT_TRUE(mfd >= 0);
+  TEST_ASSERT_EQUAL(0, grantpt(mfd));
+  TEST_ASSERT_EQUAL(0, unlockpt(mfd));
+  sfd = open(ptsname(mfd), O_RDWR | O_NOCTTY);
+  TEST_ASSERT_TRUE(sfd >= 0);
+
+  termios t;
+  tcgetattr(sfd, &t);
+  cfmakeraw(&t);
+  tcsetattr(sfd, TCSANOW, &t);
+
+  for (uint16_t i = 0; i < N_REGS; i++) regs[i] = (uint16_t)(0x1100 + i);
+  memset(coils, 0, sizeof(coils));
+  mb_core_init(core, SLAVE, MbModel{ read_regs, write_regs, read_coils, write_coils });
+}
+
+void tearDown()
+{
+  close(sfd);
+  close(mfd);
+}
+
+/* ===================== Tests ===================== */
+static void test_read_holding_regs()
+{
+  const uint8_t pdu[] = { 0x03, 0x00, 0x02, 0x00, 0x03 };
+  uint8_t reply[300];
+  TEST_ASSERT_EQUAL(5 + 6, transact(SLAVE, pdu, sizeof(pdu), reply));
+  const uint8_t want[] = { SLAVE, 0x03, 6, 0x11, 0x02, 0x11, 0x03, 0x11, 0x04 };
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(want, reply, sizeof(want));
+}
+
+static void test_write_single_reg_echoes()
+{
+  const uint8_t pdu[] = { 0x06, 0x00, 0x05, 0x12, 0x34 };
+  uint8_t reply[300];
+  TEST_ASSERT_EQUAL(8, transact(SLAVE, pdu, sizeof(pdu), reply));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(pdu, &reply[1], sizeof(pdu));
+  TEST_ASSERT_EQUAL_HEX16(0x1234, regs[5]);
+}
+
+static void test_write_multiple_regs()
+{
+  const uint8_t pdu[] = { 0x10, 0x00, 0x02, 0x00, 0x02, 4, 0x00, 0x01, 0xE2, 0x40 };
+  uint8_t reply[300];
+  TEST_ASSERT_EQUAL(8, transact(SLAVE, pdu, sizeof(pdu), reply));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(pdu, &reply[1], 5);
+  TEST_ASSERT_EQUAL_UINT32(123456, ((uint32_t)regs[2] << 16) | regs[3]);
+}
+
+static void test_coils_write_and_read()
+{
+  const uint8_t on[] = { 0x05, 0x00, 0x09, 0xFF, 0x00 };
+  uint8_t reply[300];
+  TEST_ASSERT_EQUAL(8, transact(SLAVE, on, sizeof(on), reply));
+  TEST_ASSERT_EQUAL(1, coils[9]);
+
+  const uint8_t multi[] = { 0x0F, 0x00, 0x00, 0x00, 0x0A, 2, 0x05, 0x02 };
+  TEST_ASSERT_EQUAL(8, transact(SLAVE, multi, sizeof(multi), reply));
+
+  const uint8_t rd[] = { 0x01, 0x00, 0x00, 0x00, 0x0A };
+  TEST_ASSERT_EQUAL(5 + 2, transact(SLAVE, rd, sizeof(rd), reply));
+  TEST_ASSERT_EQUAL(2, reply[2]);
+  TEST_ASSERT_EQUAL_HEX8(0x05, reply[3]);
+  TEST_ASSERT_EQUAL_HEX8(0x02, reply[4]);
+}
+
+static void test_bad_crc_is_dropped()
+{
+  const uint8_t pdu[] = { 0x03, 0x00, 0x00, 0x00, 0x01, 0xDE, 0xAD };
+  uint8_t reply[300];
+  TEST_ASSERT_EQUAL(0, transact(SLAVE, pdu, sizeof(pdu), reply, true));
+  TEST_ASSERT_EQUAL_UINT32(1, core.errors);
+
+  // the next frame after the gap is answered again
+  const uint8_t ok[] = { 0x03, 0x00, 0x00, 0x00, 0x01 };
+  TEST_ASSERT_EQUAL(7, transact(SLAVE, ok, sizeof(ok), reply));
+}
+
+static void test_other_slave_is_ignored()
+{
+  const uint8_t pdu[] = { 0x06, 0x00, 0x00, 0xBE, 0xEF };
+  uint8_t reply[300];
+  TEST_ASSERT_EQUAL(0, transact(SLAVE + 1, pdu, sizeof(pdu), reply));
+  TEST_ASSERT_EQUAL_HEX16(0x1100, regs[0]);
+  TEST_ASSERT_EQUAL_UINT32(0, core.errors);
+
+  const uint8_t ok[] = { 0x03, 0x00, 0x00, 0x00, 0x01 };
+  TEST_ASSERT_EQUAL(7, transact(SLAVE, ok, sizeof(ok), reply));
+}
+
+static void test_broadcast_acts_without_reply()
+{
+  const uint8_t pdu[] = { 0x06, 0x00, 0x01, 0x00, 0x2A };
+  uint8_t reply[300];
+  TEST_ASSERT_EQUAL(0, transact(0, pdu, sizeof(pdu), reply));
+  TEST_ASSERT_EQUAL(42, regs[1]);
+}
+
+static void test_fc15_byte_count_mismatch()
+{
+  // 10 coils need 2 bytes, header claims 1
+  const uint8_t pdu[] = { 0x0F, 0x00, 0x00, 0x00, 0x0A, 1, 0xFF };
+  expect_exception(pdu, sizeof(pdu), MB_EX_ILLEGAL_VALUE);
+  TEST_ASSERT_EQUAL(0, coils[0]);
+}
+
+static void test_fc16_byte_count_mismatch()
+{
+  // 2 registers need 4 bytes, header claims 2
+  const uint8_t pdu[] = { 0x10, 0x00, 0x00, 0x00, 0x02, 2, 0x00, 0x07 };
+  expect_exception(pdu, sizeof(pdu), MB_EX_ILLEGAL_VALUE);
+  TEST_ASSERT_EQUAL_HEX16(0x1100, regs[0]);
+}
+
+static void test_illegal_address()
+{
+  const uint8_t rd[] = { 0x03, 0x00, 0x0F, 0x00, 0x02 };
+  expect_exception(rd, sizeof(rd), MB_EX_ILLEGAL_ADDR);
+  const uint8_t wr[] = { 0x05, 0x00, 0x20, 0xFF, 0x00 };
+  expect_exception(wr, sizeof(wr), MB_EX_ILLEGAL_ADDR);
+}
+
+static void test_illegal_quantity()
+{
+  const uint8_t pdu[] = { 0x03, 0x00, 0x00, 0x00, 0x00 };
+  expect_exception(pdu, sizeof(pdu), MB_EX_ILLEGAL_VALUE);
+}
+
+static void test_unknown_function_is_dropped()
+{
+  // length unknown, so the frame cannot be delimited: skipped up to the gap
+  const uint8_t pdu[] = { 0x2B, 0x0E, 0x01, 0x00 };
+  uint8_t reply[300];
+  TEST_ASSERT_EQUAL(0, transact(SLAVE, pdu, sizeof(pdu), reply));
+  TEST_ASSERT_EQUAL_UINT32(1, core.errors);
+}
+
+static void test_split_frame_across_writes()
+{
+  // bytes trickling in without a gap still make one frame
+  uint8_t frame[] = { SLAVE, 0x03, 0x00, 0x04, 0x00, 0x01, 0, 0 };
+  const uint16_t crc = crc16(frame, 6);
+  frame[6] = crc & 0xFF;
+  frame[7] = crc >> 8;
+
+  mb_core_gap(core);
+  uint16_t len = 0;
+  for (size_t i = 0; i < sizeof(frame); i++) {
+    TEST_ASSERT_EQUAL(1, mb_core_feed(core, &frame[i], 1, &len));
+    if (i + 1 < sizeof(frame)) TEST_ASSERT_EQUAL(0, len);
+  }
+  TEST_ASSERT_EQUAL(7, len);
+  TEST_ASSERT_EQUAL_HEX8(0x11, core.tx[3]);
+  TEST_ASSERT_EQUAL_HEX8(0x04, core.tx[4]);
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_read_holding_regs);
+  RUN_TEST(test_write_single_reg_echoes);
+  RUN_TEST(test_write_multiple_regs);
+  RUN_TEST(test_coils_write_and_read);
+  RUN_TEST(test_bad_crc_is_dropped);
+  RUN_TEST(test_other_slave_is_ignored);
+  RUN_TEST(test_broadcast_acts_without_reply);
+  RUN_TEST(test_fc15_byte_count_mismatch);
+  RUN_TEST(test_fc16_byte_count_mismatch);
+  RUN_TEST(test_illegal_address);
+  RUN_TEST(test_illegal_quantity);
+  RUN_TEST(test_unknown_function_is_dropped);
+  RUN_TEST(test_split_frame_across_writes);
+  return UNITY_END();
+}
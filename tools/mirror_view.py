@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""Remote viewer for the Bandware screen mirror (see src/mirror.h).
+
+Rebuilds the panel from the row frames streamed over serial and sends
+mouse clicks/drags back as touches.
+
+  python3 tools/mirror_view.py /dev/ttyUSB0            # 921600 baud
+  python3 tools/mirror_view.py COM4 --scale 0.75
+
+Needs pyserial and pygame.
+"""
+import argparse
+import struct
+import sys
+import time
+
+SYNC_TX = b"\xa5\x5b"
+SYNC_RX = b"\xa5\x5c"
+T_ROW, T_HELLO, T_TOUCH, T_REFRESH = 0x01, 0x02, 0x10, 0x11
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def frame(ftype, payload=b""):
+    body = struct.pack("<BH", ftype, len(payload)) + payload
+    return SYNC_RX + body + struct.pack("<H", crc16_ccitt(body))
+
+
+def rgb(px):
+    return ((px >> 8) & 0xF8) | ((px >> 13) & 0x07), \
+           ((px >> 3) & 0xFC) | ((px >> 9) & 0x03), \
+           ((px << 3) & 0xF8) | ((px >> 2) & 0x07)
+
+
+class Screen:
+    """RGB888 copy of the panel, updated from decoded frames."""
+
+    def __init__(self, w=800, h=480):
+        self.resize(w, h)
+        self.buf = bytearray()
+        self.bytes_in = 0
+        self.bad = 0
+
+    def resize(self, w, h):
+        self.w, self.h = w, h
+        self.rgb = bytearray(w * h * 3)
+
+    def feed(self, data):
+        """Returns the number of rows applied."""
+        self.bytes_in += len(data)
+        self.buf += data
+        rows = 0
+        while True:
+            i = self.buf.find(SYNC_TX)
+            if i < 0:
+                del self.buf[:-1]
+                return rows
+            del self.buf[:i]
+            if len(self.buf) < 5:
+                return rows
+            ftype, n = struct.unpack_from("<BH", self.buf, 2)
+            if n > 2048:
+                del self.buf[:1]
+                continue
+            end = 5 + n + 2
+            if len(self.buf) < end:
+                return rows
+            if crc16_ccitt(self.buf[2:5 + n]) != struct.unpack_from("<H", self.buf, 5 + n)[0]:
+                self.bad += 1
+                del self.buf[:1]
+                continue
+            payload = bytes(self.buf[5:5 + n])
+            del self.buf[:end]
+            if ftype == T_HELLO:
+                self.resize(*struct.unpack("<HH", payload))
+            elif ftype == T_ROW:
+                self.apply_row(payload)
+                rows += 1
+
+    def apply_row(self, p):
+        x, y, w = struct.unpack_from("<HHH", p)
+        if y >= self.h or x + w > self.w:
+            return
+        o = (y * self.w + x) * 3
+        i = 6
+        while i < len(p):
+            op = p[i]
+            cnt = (op & 0x3F) + 1
+            kind = op >> 6
+            i += 1
+            if kind == 0:
+                o += cnt * 3
+            elif kind == 1:
+                self.rgb[o:o + cnt * 3] = bytes(rgb(p[i] | (p[i + 1] << 8))) * cnt
+                i += 2
+                o += cnt * 3
+            else:
+                for _ in range(cnt):
+                    self.rgb[o:o + 3] = bytes(rgb(p[i] | (p[i + 1] << 8)))
+                    i += 2
+                    o += 3
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("port")
+    ap.add_argument("--baud", type=int, default=921600)
+    ap.add_argument("--scale", type=float, default=1.0)
+    args = ap.parse_args()
+
+    import pygame
+    import serial
+
+    port = serial.Serial(args.port, args.baud, timeout=0)
+    scr = Screen()
+    port.write(frame(T_REFRESH))
+
+    pygame.init()
+    win = None
+    down = False
+    last_touch = 0.0
+    t_stat, b_stat = time.monotonic(), 0
+
+    while True:
+        scr.feed(port.read(65536))
+        size = (int(scr.w * args.scale), int(scr.h * args.scale))
+        if win is None or win.get_size() != size:
+            win = pygame.display.set_mode(size)
+
+        for ev in pygame.event.get():
+            if ev.type == pygame.QUIT:
+                return 0
+            if ev.type in (pygame.MOUSEBUTTONDOWN, pygame.MOUSEBUTTONUP, pygame.MOUSEMOTION):
+                if ev.type == pygame.MOUSEBUTTONDOWN:
+                    down = True
+                elif ev.type == pygame.MOUSEBUTTONUP:
+                    down = False
+                elif not down:
+                    continue
+                x = min(scr.w - 1, max(0, int(ev.pos[0] / args.scale)))
+                y = min(scr.h - 1, max(0, int(ev.pos[1] / args.scale)))
+                port.write(frame(T_TOUCH, struct.pack("<HHB", x, y, 1 if down else 0)))
+                last_touch = time.monotonic()
+            if ev.type == pygame.KEYDOWN and ev.key == pygame.K_r:
+                port.write(frame(T_REFRESH))
+
+        # the device drops a touch it has not heard about for 500 ms
+        if down and time.monotonic() - last_touch > 0.2:
+            x, y = pygame.mouse.get_pos()
+            port.write(frame(T_TOUCH, struct.pack("<HHB", int(x / args.scale), int(y / args.scale), 1)))
+            last_touch = time.monotonic()
+
+        img = pygame.image.frombuffer(bytes(scr.rgb), (scr.w, scr.h), "RGB")
+        if args.scale != 1.0:
+            img = pygame.transform.smoothscale(img, size)
+        win.blit(img, (0, 0))
+        pygame.display.flip()
+
+        now = time.monotonic()
+        if now - t_stat >= 1.0:
+            pygame.display.set_caption("Bandware mirror  %.1f kB/s  crc errors %d  (R = refresh)" % (
+                (scr.bytes_in - b_stat) / 1024.0 / (now - t_stat), scr.bad))
+            t_stat, b_stat = now, scr.bytes_in
+        time.sleep(0.01)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""Minimal Modbus RTU master for the Bandware counter (PLC/MES stand-in).
+
+Polls the per-lane register block once a second and can send START/STOP/
+RESET or a new target. Works on a USB-RS485 adapter or any serial device,
+e.g. one end of a socat pty pair for bench testing.
+
+  python3 tools/modbus_poll.py /dev/ttyUSB0 --lanes 2
+  python3 tools/modbus_poll.py /dev/ttyUSB0 --lane 1 --ziel 250 --start
+
+Needs pyserial.
+"""
+import argparse
+import struct
+import sys
+import time
+
+import serial
+
+LANE_REGS = 8
+LANE_COILS = 8
+STATES = ["IDLE", "RUNNING", "DONE", "STOPPED", "ERROR", "CHANGEOVER"]
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0xA001 if crc & 1 else crc >> 1
+    return crc
+
+
+def transact(port, pdu, slave, reply_len):
+    frame = bytes([slave]) + pdu
+    frame += struct.pack("<H", crc16(frame))
+    port.reset_input_buffer()
+    port.write(frame)
+    # exception replies are 5 bytes; read the header first to tell them apart
+    head = port.read(2)
+    if len(head) < 2:
+        raise IOError("timeout")
+    if head[1] & 0x80:
+        rest = port.read(3)
+        raise IOError("exception %d" % rest[0])
+    rest = port.read(reply_len - 2)
+    reply = head + rest
+    if len(reply) != reply_len or crc16(reply) != 0:
+        raise IOError("bad reply %s" % reply.hex())
+    return reply
+
+
+def read_regs(port, slave, addr, n):
+    r = transact(port, struct.pack(">BHH", 3, addr, n), slave, 5 + 2 * n)
+    return struct.unpack(">%dH" % n, r[3:3 + 2 * n])
+
+
+def write_regs(port, slave, addr, values):
+    pdu = struct.pack(">BHHB", 16, addr, len(values), 2 * len(values))
+    pdu += struct.pack(">%dH" % len(values), *values)
+    transact(port, pdu, slave, 8)
+
+
+def write_coil(port, slave, addr, on=True):
+    transact(port, struct.pack(">BHH", 5, addr, 0xFF00 if on else 0), slave, 8)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("port")
+    ap.add_argument("--baud", type=int, default=19200)
+    ap.add_argument("--slave", type=int, default=1)
+    ap.add_argument("--lanes", type=int, default=1)
+    ap.add_argument("--lane", type=int, default=1, help="lane for commands (1-based)")
+    ap.add_argument("--ziel", type=int)
+    ap.add_argument("--start", action="store_true")
+    ap.add_argument("--stop", action="store_true")
+    ap.add_argument("--reset", action="store_true")
+    ap.add_argument("--interval", type=float, default=1.0)
+    args = ap.parse_args()
+
+    port = serial.Serial(args.port, args.baud, parity=serial.PARITY_EVEN, timeout=0.2)
+    lane = args.lane - 1
+
+    if args.ziel is not None:
+        write_regs(port, args.slave, lane * LANE_REGS + 2, [args.ziel >> 16, args.ziel & 0xFFFF])
+    for flag, coil in ((args.reset, 2), (args.stop, 1), (args.start, 0)):
+        if flag:
+            write_coil(port, args.slave, lane * LANE_COILS + coil)
+    if args.ziel is not None or args.start or args.stop or args.reset:
+        return 0
+
+    while True:
+        t0 = time.monotonic()
+        try:
+            regs = read_regs(port, args.slave, 0, args.lanes * LANE_REGS)
+        except IOError as e:
+            print("poll failed:", e)
+        else:
+            line = []
+            for i in range(args.lanes):
+                r = regs[i * LANE_REGS:(i + 1) * LANE_REGS]
+                ist, ziel = (r[0] << 16) | r[1], (r[2] << 16) | r[3]
+                unit = " cm" if r[7] else ""
+                line.append("L%d %s %d/%d%s deb=%dms motor=%d" % (
+                    i + 1, STATES[r[5]] if r[5] < len(STATES) else r[5], ist, ziel, unit, r[4], r[6]))
+            print("  |  ".join(line), "(%.0f ms)" % ((time.monotonic() - t0) * 1000))
+        time.sleep(max(0.0, args.interval - (time.monotonic() - t0)))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
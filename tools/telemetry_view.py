@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""Decoder for the Bandware binary telemetry stream (see src/telemetry.h).
+
+  python3 tools/telemetry_view.py /dev/ttyUSB0               # print records
+  python3 tools/telemetry_view.py /dev/ttyUSB0 --csv log.csv # also log
+  python3 tools/telemetry_view.py /dev/ttyUSB0 --plot        # live plot
+  python3 tools/telemetry_view.py --file capture.bin         # offline
+
+Needs pyserial for live ports and matplotlib for --plot.
+"""
+import argparse
+import collections
+import struct
+import sys
+
+SYNC = b"\xa5\x5a"
+RECORD = struct.Struct("<HIBBBBIIHHIH")   # TelRecord, 28 bytes
+FIELDS = ("seq", "t_ms", "lane", "state", "motor", "flags", "count", "rate_pm",
+          "loop_avg_us", "loop_max_us", "heap_free", "dropped")
+STATES = ["IDLE", "RUNNING", "DONE", "STOPPED", "ERROR", "CHANGEOVER"]
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class Decoder:
+    """Feeds raw bytes, yields record dicts; resyncs on sync bytes + CRC."""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.bad = 0
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            i = self.buf.find(SYNC)
+            if i < 0:
+                del self.buf[:-1]   # keep a possible half sync byte
+                return
+            del self.buf[:i]
+            if len(self.buf) < 3:
+                return
+            n = self.buf[2]
+            if n != RECORD.size:
+                del self.buf[:1]
+                continue
+            end = 3 + n + 2
+            if len(self.buf) < end:
+                return
+            crc = self.buf[end - 2] | (self.buf[end - 1] << 8)
+            if crc16_ccitt(self.buf[2:3 + n]) != crc:
+                self.bad += 1
+                del self.buf[:1]
+                continue
+            rec = dict(zip(FIELDS, RECORD.unpack_from(self.buf, 3)))
+            del self.buf[:end]
+            yield rec
+
+
+def fmt(r):
+    st = STATES[r["state"]] if r["state"] < len(STATES) else str(r["state"])
+    unit = "cm" if r["flags"] & 1 else "pcs"
+    return ("#%5d %9.3fs L%d %-10s motor=%d count=%d %s rate=%d/min loop=%d/%dus heap=%d drop=%d" % (
+        r["seq"], r["t_ms"] / 1000.0, r["lane"] + 1, st, r["motor"], r["count"], unit,
+        r["rate_pm"], r["loop_avg_us"], r["loop_max_us"], r["heap_free"], r["dropped"]))
+
+
+def records(args):
+    dec = Decoder()
+    if args.file:
+        with open(args.file, "rb") as f:
+            for r in dec.feed(f.read()):
+                yield r
+        return
+    import serial
+    port = serial.Serial(args.port, args.baud, timeout=0.1)
+    while True:
+        for r in dec.feed(port.read(4096)):
+            yield r
+
+
+def plot(src, window):
+    import matplotlib.pyplot as plt
+    hist = collections.defaultdict(lambda: collections.deque(maxlen=window))
+    plt.ion()
+    fig, (ax_c, ax_r, ax_l) = plt.subplots(3, 1, sharex=True)
+    for n, r in enumerate(src):
+        hist[r["lane"]].append((r["t_ms"] / 1000.0, r["count"], r["rate_pm"], r["loop_max_us"]))
+        if n % 10:
+            continue
+        for ax in (ax_c, ax_r, ax_l):
+            ax.cla()
+        for lane, h in sorted(hist.items()):
+            t, c, rate, lm = zip(*h)
+            ax_c.plot(t, c, label="Spur %d" % (lane + 1))
+            ax_r.plot(t, rate)
+            ax_l.plot(t, lm)
+        ax_c.set_ylabel("count")
+        ax_r.set_ylabel("rate /min")
+        ax_l.set_ylabel("loop max us")
+        ax_l.set_xlabel("s")
+        ax_c.legend(loc="upper left")
+        plt.pause(0.001)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("port", nargs="?")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--file")
+    ap.add_argument("--csv")
+    ap.add_argument("--plot", action="store_true")
+    ap.add_argument("--window", type=int, default=600, help="points per lane in the plot")
+    args = ap.parse_args()
+    if not args.port and not args.file:
+        ap.error("need a port or --file")
+
+    csv = open(args.csv, "w") if args.csv else None
+    if csv:
+        csv.write(",".join(FIELDS) + "\n")
+
+    def tee():
+        for r in records(args):
+            if csv:
+                csv.write(",".join(str(r[k]) for k in FIELDS) + "\n")
+            yield r
+
+    try:
+        if args.plot:
+            plot(tee(), args.window)
+        else:
+            for r in tee():
+                print(fmt(r))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if csv:
+            csv.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())